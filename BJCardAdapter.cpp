@@ -0,0 +1,39 @@
+//---------------------------------------------------------------------------
+#include <System.SysUtils.hpp>
+#include <System.hpp>
+#pragma hdrstop
+
+#include "BJCardAdapter.h"
+//---------------------------------------------------------------------------
+
+#pragma package(smart_init)
+
+String __fastcall BJCardAdapter::GetCardsFolder()
+{
+    String exePath   = ExtractFilePath(ParamStr(0));
+    String cardsPath = ExpandFileName(exePath + "..\\..\\cards\\");
+    return cardsPath;
+}
+
+String __fastcall BJCardAdapter::GetCardFileName(const BJCard& c)
+{
+    String rankStr = c.getGlyph();
+
+    String suitStr;
+    switch (c.getSuit()) {
+        case BJSuit::SuitClub:    suitStr = "C"; break;
+        case BJSuit::SuitDiamond: suitStr = "D"; break;
+        case BJSuit::SuitHeart:   suitStr = "H"; break;
+        case BJSuit::SuitSpade:   suitStr = "S"; break;
+    }
+
+    return rankStr + suitStr + ".png";
+}
+
+String BJCardAdapter::DescribePoints(const BJHand& h)
+{
+    if (h.isSoft())
+        return "Soft " + IntToStr(h.value());
+
+    return IntToStr(h.getHardTotal());
+}
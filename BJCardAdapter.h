@@ -0,0 +1,23 @@
+//---------------------------------------------------------------------------
+#ifndef BJCardAdapterH
+#define BJCardAdapterH
+//---------------------------------------------------------------------------
+
+#include <System.hpp>
+
+#include "engine/BJCard.h"
+#include "engine/BJHand.h"
+
+// FMX-side helpers for the headless engine: card bitmap paths and the
+// String formatting the labels use.
+
+class BJCardAdapter {
+public:
+    static String __fastcall GetCardsFolder();
+    static String __fastcall GetCardFileName(const BJCard& c);
+
+    static String DescribePoints(const BJHand& h);
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -8,6 +8,10 @@
 
 #include <FMX.ListBox.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
 //---------------------------------------------------------------------------
 
 #pragma package(smart_init)
@@ -71,6 +75,61 @@ __fastcall TFormMainMenu::TFormMainMenu(TComponent* Owner)
             item->TextSettings->HorzAlign    = TTextAlign::Center;
         }
     }
+
+    lblGoalOdds = new TLabel(this);
+    lblGoalOdds->Parent = this;
+
+    lblGoalOdds->Width  = 420;
+    lblGoalOdds->Height = 32;
+
+    lblGoalOdds->StyledSettings = TStyledSettings();
+    lblGoalOdds->TextSettings->Font->Family = "Cooper";
+    lblGoalOdds->TextSettings->Font->Size   = 16;
+
+    lblGoalOdds->Position->X = EditGoalMoney->Position->X;
+    lblGoalOdds->Position->Y = EditGoalMoney->Position->Y + EditGoalMoney->Height + 8;
+
+    oddsDecks    = 0;
+    pendingDecks = 0;
+
+    oddsTimer = new TTimer(this);
+    oddsTimer->Enabled  = false;
+    oddsTimer->Interval = 50;
+    oddsTimer->OnTimer  = OddsTimerTick;
+
+    UpdateGoalOdds();
+
+    ComboBoxBots = new TComboBox(this);
+    ComboBoxBots->Parent = this;
+    ComboBoxBots->Items->Add("No bots");
+    ComboBoxBots->Items->Add("Basic strategy bots");
+    ComboBoxBots->Items->Add("Card counting bots");
+    ComboBoxBots->Items->Add("Random bots");
+    ComboBoxBots->Items->Add("Flat-bet bots");
+    ComboBoxBots->Items->Add("One of each");
+    ComboBoxBots->ItemIndex = 0;
+
+    ComboBoxBots->Width  = 240;
+    ComboBoxBots->Height = 32;
+    ComboBoxBots->Position->X = ComboBoxPlayerCountMain->Position->X;
+    ComboBoxBots->Position->Y = ComboBoxPlayerCountMain->Position->Y
+                              + ComboBoxPlayerCountMain->Height + 8;
+
+    CheckBoxFastBots = new TCheckBox(this);
+    CheckBoxFastBots->Parent = this;
+    CheckBoxFastBots->Text   = "Bots take every seat (fast, no animations)";
+    CheckBoxFastBots->Width  = 360;
+    CheckBoxFastBots->Position->X = ComboBoxBots->Position->X;
+    CheckBoxFastBots->Position->Y = ComboBoxBots->Position->Y + ComboBoxBots->Height + 4;
+
+    CheckBoxFastBots->StyledSettings = TStyledSettings();
+    CheckBoxFastBots->TextSettings->Font->Family = "Cooper";
+    CheckBoxFastBots->TextSettings->Font->Size   = 16;
+
+    ComboBoxBots->OnChange     = BotsChange;
+    CheckBoxFastBots->OnChange = BotsChange;
+
+    ApplyBotSeats();
 }
 
 //---------------------------------------------------------------------------
@@ -192,6 +251,7 @@ void __fastcall TFormMainMenu::EditStartMoneyExit(TObject *Sender)
     }
 
     Settings::getInstance().player_initial_chips = value;
+    UpdateGoalOdds();
 }
 
 //---------------------------------------------------------------------------
@@ -211,6 +271,102 @@ void __fastcall TFormMainMenu::EditGoalMoneyExit(TObject *Sender)
     }
 
 	Settings::getInstance().goal_amount = value;
+    UpdateGoalOdds();
+}
+
+//---------------------------------------------------------------------------
+// BOT SEATS: player 1 keeps the buttons unless bots take every seat
+//---------------------------------------------------------------------------
+
+void __fastcall TFormMainMenu::BotsChange(TObject *Sender)
+{
+    ApplyBotSeats();
+}
+
+void TFormMainMenu::ApplyBotSeats()
+{
+    static const BJBotKind mixed[Settings::MaxPlayers] = {
+        BJBotKind::Basic, BJBotKind::Counting, BJBotKind::Random, BJBotKind::FlatBet
+    };
+
+    Settings& s = Settings::getInstance();
+
+    const int  choice   = ComboBoxBots->ItemIndex;
+    const bool allSeats = CheckBoxFastBots->IsChecked;
+
+    for (int i = 0; i < Settings::MaxPlayers; ++i) {
+        BJBotKind kind = BJBotKind::Human;
+        if (choice > 0 && (i > 0 || allSeats)) {
+            kind = (choice == BJBotKindCount) ? mixed[i] : (BJBotKind)choice;
+        }
+        s.seat_bots[i] = kind;
+    }
+
+    s.fast_bots = allSeats;
+}
+
+//---------------------------------------------------------------------------
+// GOAL ODDS: chance of reaching the goal before going broke
+//---------------------------------------------------------------------------
+
+// Flat bet the odds line assumes, capped at the starting money.
+static const int kOddsBet = 10;
+
+void TFormMainMenu::UpdateGoalOdds()
+{
+    Settings& s = Settings::getInstance();
+
+    if (s.goal_amount <= s.player_initial_chips) {
+        lblGoalOdds->Text = "";
+        return;
+    }
+
+    // measured once per rule set and shoe size, off the UI thread; a
+    // measurement for older settings finishes first and the tick starts
+    // the next one
+    if (oddsDecks != s.deck_count || oddsRules != s.rules) {
+        if (!oddsJob.valid()) {
+            pendingRules = s.rules;
+            pendingDecks = s.deck_count;
+            oddsJob = std::async(std::launch::async, [rules = s.rules, decks = s.deck_count]() {
+                return BJBasicStrategyRounds(rules, decks);
+            });
+            oddsTimer->Enabled = true;
+        }
+        lblGoalOdds->Text = "Chance to reach goal: working it out...";
+        return;
+    }
+
+    const int bet = std::min(kOddsBet, s.player_initial_chips);
+
+    double reach;
+    try {
+        reach = BJGoalOddsExact(oddsRounds, s.player_initial_chips, s.goal_amount, bet).reach;
+    } catch (const std::length_error&) {
+        reach = BJGoalReachDiffusion(oddsRounds, s.player_initial_chips, s.goal_amount, bet);
+    }
+
+    lblGoalOdds->Text = "Chance to reach goal: " + FormatFloat("0.0", 100.0 * reach)
+                      + "% (basic strategy, " + IntToStr(bet) + " a hand)";
+}
+
+void __fastcall TFormMainMenu::OddsTimerTick(TObject *Sender)
+{
+    if (!oddsJob.valid() ||
+        oddsJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    oddsTimer->Enabled = false;
+    try {
+        oddsRounds = oddsJob.get();
+    } catch (const std::exception&) {
+        lblGoalOdds->Text = "";        // tried again on the next change
+        return;
+    }
+    oddsRules = pendingRules;
+    oddsDecks = pendingDecks;
+
+    UpdateGoalOdds();
 }
 
 //---------------------------------------------------------------------------
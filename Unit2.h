@@ -16,6 +16,9 @@
 #include <FMX.WebBrowser.hpp>
 #include <System.UITypes.hpp>
 
+#include <future>
+
+#include "engine/BJGoalOdds.h"
 
 //---------------------------------------------------------------------------
 
@@ -59,6 +62,30 @@ void __fastcall EditFixEmpty(TObject *Sender);
     void __fastcall EditStartMoneyExit(TObject *Sender);
     void __fastcall EditGoalMoneyExit(TObject *Sender);
 
+private:        // User declarations
+    TLabel* lblGoalOdds;     // created at runtime, under the goal edit
+
+    // The round distribution the odds use, measured per rule set and shoe
+    // size on a worker thread (a few seconds for generated tables); the
+    // timer picks the result up on the UI thread.
+    BJRuntimeRules                   oddsRules;
+    int                              oddsDecks;        // 0 until one is measured
+    BJRoundDistribution              oddsRounds;
+    BJRuntimeRules                   pendingRules;
+    int                              pendingDecks;
+    std::future<BJRoundDistribution> oddsJob;
+    TTimer*                          oddsTimer;
+
+    void UpdateGoalOdds();
+    void __fastcall OddsTimerTick(TObject *Sender);
+
+    // Bot seats, created at runtime under the player count
+    TComboBox* ComboBoxBots;
+    TCheckBox* CheckBoxFastBots;
+
+    void __fastcall BotsChange(TObject *Sender);
+    void ApplyBotSeats();
+
 public:         // User declarations
     __fastcall TFormMainMenu(TComponent* Owner);
 };
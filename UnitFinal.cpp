@@ -3,23 +3,28 @@
 #include <vector>
 #include <string>
 #include <algorithm>
-#include <random>
-#include <stdexcept>
-#include <chrono>
+#include <fstream>
 
 #include <System.SysUtils.hpp>
+#include <System.IOUtils.hpp>
 #include <System.hpp>
 
-#include <cstdlib>
+#include "engine/BJRandom.h"
+
+static BJSplitMix64& UiRng()
+{
+    static BJSplitMix64 rng(BJRandomSeed());
+    return rng;
+}
 
 static int RandInt(int min, int max)
 {
-    return min + std::rand() % (max - min + 1);
+    return min + (int)BJRandomBelow(UiRng(), (std::uint32_t)(max - min + 1));
 }
 
 static float RandRange(float min, float max)
 {
-    float t = (float)std::rand() / (float)RAND_MAX;
+    float t = BJRandomUnitFloat(UiRng());
     return min + (max - min) * t;
 }
 
@@ -30,643 +35,14 @@ static float RandRange(float min, float max)
 
 #include "Unit2.h"
 #include "UnitFinal.h"
+#include "BJCardAdapter.h"
+#include "engine/BJEngine.h"
 
 //---------------------------------------------------------------------------
 
 #pragma package(smart_init)
 #pragma resource "*.fmx"
 
-// ---------------- ENUMS (renamed to avoid collisions) ----------------
-
-enum class BJSuit : int {
-    SuitSpade   = 0,
-    SuitHeart   = 1,
-    SuitClub    = 2,
-    SuitDiamond = 3
-};
-
-// Rank values 2–14 (10, J, Q, K, A)
-enum class BJRank : int {
-    R2 = 2, R3, R4, R5, R6, R7, R8, R9, R10,
-    RJ = 11, RQ = 12, RK = 13, RA = 14
-};
-
-enum class BJHandStatus { Active, Stood, Busted, Surrendered };
-
-// ---------------- CARD ----------------
-
-class BJCard {
-private:
-	BJSuit suit;
-    BJRank rank;
-
-public:
-	BJCard(BJSuit s, BJRank r) : suit(s), rank(r) {}
-
-	static String __fastcall GetCardsFolder();
-	static String __fastcall GetCardFileName(const BJCard& c);
-
-    BJSuit getSuit() const { return suit; }
-    BJRank getRank() const { return rank; }
-
-    std::string toString() const;
-};
-
-// --- BJCard method definitions ---
-
-String __fastcall BJCard::GetCardsFolder()
-{
-    String exePath   = ExtractFilePath(ParamStr(0));
-    String cardsPath = ExpandFileName(exePath + "..\\..\\cards\\");
-    return cardsPath;
-}
-
-String __fastcall BJCard::GetCardFileName(const BJCard& c)
-{
-    String rankStr;
-    int r = static_cast<int>(c.getRank());
-
-    if (r >= 2 && r <= 10)
-        rankStr = IntToStr(r);
-    else if (r == 11)
-        rankStr = "J";
-    else if (r == 12)
-        rankStr = "Q";
-    else if (r == 13)
-        rankStr = "K";
-    else if (r == 14)
-        rankStr = "A";
-
-    String suitStr;
-    switch (c.getSuit()) {
-        case BJSuit::SuitClub:    suitStr = "C"; break;
-        case BJSuit::SuitDiamond: suitStr = "D"; break;
-        case BJSuit::SuitHeart:   suitStr = "H"; break;
-        case BJSuit::SuitSpade:   suitStr = "S"; break;
-    }
-
-    return rankStr + suitStr + ".png";
-}
-
-std::string BJCard::toString() const
-{
-    static const char* suitNames[] = {
-        "Spades", "Hearts", "Clubs", "Diamonds"
-    };
-    static const char* rankNames[] = {
-        "", "", "2","3","4","5","6","7","8","9","10","J","Q","K","A"
-    };
-
-    return std::string(rankNames[(int)rank]) + " of " + suitNames[(int)suit];
-};
-
-// ---------------- HAND ----------------
-
-class BJHand {
-private:
-    std::vector<BJCard> hand;
-    BJHandStatus status;
-public:
-    BJHand() : status(BJHandStatus::Active) {}
-
-    void addCard(const BJCard& c) { hand.push_back(c); }
-    int  size() const             { return (int)hand.size(); }
-
-    int value() const {
-        int value = 0;
-        int ace_count = 0;
-
-        for (const auto& card : hand) {
-            int r = static_cast<int>(card.getRank());
-
-            if (r <= 10) {
-                value += r;
-            } else if (r <= 13) {
-                value += 10;
-            } else {
-                ++ace_count;
-            }
-        }
-
-        while (ace_count > 0) {
-            if (21 - value >= 11) {
-                value += 11;
-            } else {
-                value += 1;
-            }
-            --ace_count;
-        }
-
-        return value;
-    }
-
-    void clear() {
-        hand.clear();
-        status = BJHandStatus::Active;
-    }
-
-    const std::vector<BJCard>& GetCards() const { return hand; }
-
-    BJHandStatus getStatus() const { return status; }
-    void setStatus(BJHandStatus s) { status = s; }
-
-    std::string toString() const {
-        std::string output;
-        for (const auto& card : hand) {
-            output += card.toString() + "\n";
-        }
-        return output;
-    }
-};
-
-static String DescribePoints(const BJHand& h)
-{
-    const auto& cards = h.GetCards();
-    int nonAce = 0;
-    int aces   = 0;
-
-    for (const auto& card : cards) {
-        int r = static_cast<int>(card.getRank());
-        if (r == static_cast<int>(BJRank::RA)) {
-            ++aces;
-        } else if (r >= 2 && r <= 10) {
-            nonAce += r;
-        } else if (r >= 11 && r <= 13) {
-            nonAce += 10;
-        }
-    }
-
-    int hardTotal = nonAce + aces;
-    int softTotal = hardTotal;
-
-    if (aces > 0 && hardTotal + 10 <= 21) {
-        softTotal = hardTotal + 10;
-        return "Soft " + IntToStr(softTotal);
-    }
-
-    return IntToStr(hardTotal);
-}
-
-// ---------------- DECK ----------------
-
-class BJDeck {
-private:
-    std::vector<BJCard> cards;
-	int index;
-
-public:
-    BJDeck() : index(0) {
-        resetDeck();
-    }
-
-	void resetDeck() {
-        cards.clear();
-
-        for (int s = 0; s < 4; ++s) {
-            for (int r = 2; r <= 14; ++r) {
-                cards.emplace_back((BJSuit)s, (BJRank)r);
-            }
-        }
-
-        index = 0;
-        shuffleCards();
-    }
-
-    void shuffleCards() {
-        std::random_device rd;
-        auto timeSeed = std::chrono::high_resolution_clock::now()
-                            .time_since_epoch().count();
-
-        unsigned int seed =
-            static_cast<unsigned int>(rd()) ^
-            static_cast<unsigned int>(timeSeed);
-
-        std::mt19937 rng(seed);
-        std::shuffle(cards.begin(), cards.end(), rng);
-    }
-
-    BJCard DrawCard() {
-        if (index >= (int)cards.size()) {
-            throw std::runtime_error("Deck empty.");
-        }
-        return cards[index++];
-    }
-
-    void dealCardTo(BJHand& hand) {
-        hand.addCard(DrawCard());
-    }
-
-    int remaining() const {
-        return (int)cards.size() - index;
-    }
-};
-
-// ---------------- PLAYER ----------------
-
-class BJPlayer {
-private:
-    int     id;
-    BJHand  hand;
-	BJHand  splitHand;
-    bool    hasSplit;
-    int     chips;
-    int     currentBet;
-    int     splitBet;
-
-
-	int lastOutcomeMain;
-    int lastOutcomeSplit;
-
-	bool bankrupt;
-
-
-	bool actedMain;
-    bool actedSplit;
-
-public:
-    BJPlayer(int id, int initial_chips)
-        : id(id),
-          hand(),
-          splitHand(),
-          hasSplit(false),
-          chips(initial_chips),
-          currentBet(0),
-          splitBet(0),
-          lastOutcomeMain(0),
-          lastOutcomeSplit(0),
-          bankrupt(false),
-          actedMain(false),
-          actedSplit(false)
-    {}
-
-    int getID() const { return id; }
-
-    BJHand&       GetHand()       noexcept { return hand; }
-    const BJHand& GetHand() const noexcept { return hand; }
-
-    BJHand&       GetSplitHand()       noexcept { return splitHand; }
-    const BJHand& GetSplitHand() const noexcept { return splitHand; }
-
-    bool hasSplitHand() const noexcept { return hasSplit; }
-    void setHasSplit(bool v) noexcept  { hasSplit = v; }
-
-    int  getChips() const        noexcept { return chips; }
-    void adjustChips(int amount) noexcept { chips += amount; }
-
-    void setBet(int amount) {
-        if (amount < 0) throw std::invalid_argument("Bet cannot be negative");
-        currentBet = amount;
-    }
-    int getBet() const noexcept { return currentBet; }
-
-    void setSplitBet(int amount) {
-        if (amount < 0) throw std::invalid_argument("Bet cannot be negative");
-        splitBet = amount;
-    }
-    int getSplitBet() const noexcept { return splitBet; }
-
-    void clearHands() {
-        hand.clear();
-        splitHand.clear();
-        hasSplit = false;
-
-		lastOutcomeMain  = 0;
-        lastOutcomeSplit = 0;
-
-        actedMain  = false;
-        actedSplit = false;
-    }
-
-
-    void setRoundOutcomeMain(int o)  noexcept { lastOutcomeMain  = o; }
-    void setRoundOutcomeSplit(int o) noexcept { lastOutcomeSplit = o; }
-    int  getRoundOutcomeMain() const noexcept { return lastOutcomeMain; }
-    int  getRoundOutcomeSplit() const noexcept { return lastOutcomeSplit; }
-
-
-    bool isBankrupt() const noexcept { return bankrupt; }
-    void setBankrupt(bool v) noexcept { bankrupt = v; }
-
-	bool hasActedOnHand(int handIndex) const noexcept {
-        return (handIndex == 0 ? actedMain : actedSplit);
-    }
-
-    void markActionOnHand(int handIndex) noexcept {
-        if (handIndex == 0)
-            actedMain = true;
-        else
-            actedSplit = true;
-    }
-};
-
-
-
-// ---------------- DEALER ----------------
-
-class BJDealer {
-private:
-	BJHand hand;
-public:
-	BJDealer() : hand() {}
-
-	BJHand&       GetHand()       noexcept { return hand; }
-	const BJHand& GetHand() const noexcept { return hand; }
-
-	void clearHand() { hand.clear(); }
-};
-
-// ---------------- GAME ----------------
-
-class BJGame {
-private:
-	BJDeck deck;
-	BJDealer dealer;
-    std::vector<BJPlayer> players;
-    int current_player_index;
-    int current_hand_index;
-
-public:
-    BJGame(int player_count, int player_initial_chips)
-        : deck(), dealer(), players(), current_player_index(0), current_hand_index(0)
-    {
-        for (int i = 0; i < player_count; ++i) {
-            players.emplace_back(i, player_initial_chips);
-        }
-    }
-
-	BJDeck&       GetDeck()       noexcept { return deck; }
-    const BJDeck& GetDeck() const noexcept { return deck; }
-
-    BJDealer&       GetDealer()       noexcept { return dealer; }
-    const BJDealer& GetDealer() const noexcept { return dealer; }
-
-    BJPlayer&       GetCurrentPlayer()       { return players[current_player_index]; }
-    const BJPlayer& GetCurrentPlayer() const { return players[current_player_index]; }
-
-    BJPlayer&       GetPlayer(int i)       { return players[i]; }
-    const BJPlayer& GetPlayer(int i) const { return players[i]; }
-
-    int  getPlayerCount()        const { return (int)players.size(); }
-    int  getCurrentPlayerIndex() const { return current_player_index; }
-    int  getCurrentHandIndex()   const { return current_hand_index; }
-
-    BJHand&       GetCurrentHand() {
-        BJPlayer& p = players[current_player_index];
-        return (current_hand_index == 0 ? p.GetHand() : p.GetSplitHand());
-    }
-    const BJHand& GetCurrentHand() const {
-        const BJPlayer& p = players[current_player_index];
-        return (current_hand_index == 0 ? p.GetHand() : p.GetSplitHand());
-    }
-
-    void startRound() {
-        resetForNextRound();
-
-        for (auto& p : players) {
-            if (p.isBankrupt() || p.getBet() <= 0)
-                continue;
-            deck.dealCardTo(p.GetHand());
-            deck.dealCardTo(p.GetHand());
-        }
-
-        deck.dealCardTo(dealer.GetHand());
-        deck.dealCardTo(dealer.GetHand());
-
-        current_player_index = 0;
-        current_hand_index   = 0;
-
-        for (int i = 0; i < (int)players.size(); ++i) {
-            BJPlayer& p = players[i];
-            if (!p.isBankrupt() && p.getBet() > 0 && p.GetHand().size() > 0) {
-                current_player_index = i;
-                break;
-            }
-        }
-    }
-
-    bool advanceTurn() {
-        BJPlayer& p = players[current_player_index];
-
-        if (current_hand_index == 0 &&
-            p.hasSplitHand() &&
-            p.getSplitBet() > 0 &&
-            !p.isBankrupt())
-        {
-            current_hand_index = 1;
-            return true;
-        }
-
-        current_hand_index = 0;
-        int n = (int)players.size();
-        for (int idx = current_player_index + 1; idx < n; ++idx) {
-            BJPlayer& np = players[idx];
-            if (!np.isBankrupt() && np.getBet() > 0 && np.GetHand().size() > 0) {
-                current_player_index = idx;
-                return true;
-            }
-        }
-        return false;
-    }
-
-    void resolveDealerHand() {
-        BJHand& h = dealer.GetHand();
-        while (h.value() < 17) {
-            deck.dealCardTo(h);
-        }
-    }
-
-    void resetForNextRound() {
-        dealer.clearHand();
-        for (auto& p : players) {
-            p.clearHands();
-        }
-
-        if (deck.remaining() < 40) {
-            deck.resetDeck();
-        }
-
-        current_player_index = 0;
-        current_hand_index   = 0;
-    }
-
-    void settleBets() {
-        int dealerValue = dealer.GetHand().value();
-
-        for (auto& p : players) {
-            p.setRoundOutcomeMain(0);
-            p.setRoundOutcomeSplit(0);
-
-            {
-                BJHand& h = p.GetHand();
-                int bet   = p.getBet();
-                int outcome = 0;
-
-                if (bet > 0) {
-                    int playerValue = h.value();
-
-                    if (playerValue > 21 && dealerValue <= 21) {
-                        outcome = -1;
-                    }
-                    else if (dealerValue > 21 && playerValue <= 21) {
-                        outcome = 1;
-                        p.adjustChips(bet * 2);
-                    }
-                    else if (playerValue > dealerValue && playerValue <= 21) {
-                        outcome = 1;
-                        p.adjustChips(bet * 2);
-                    }
-                    else if (playerValue < dealerValue && dealerValue <= 21) {
-                        outcome = -1;
-                    }
-                    else {
-                        outcome = 0;
-                        p.adjustChips(bet);
-                    }
-                }
-
-                p.setRoundOutcomeMain(outcome);
-            }
-
-            if (p.hasSplitHand()) {
-                BJHand& h2 = p.GetSplitHand();
-                int bet2   = p.getSplitBet();
-                int outcome2 = 0;
-
-                if (bet2 > 0) {
-                    int playerValue2 = h2.value();
-
-                    if (playerValue2 > 21 && dealerValue <= 21) {
-                        outcome2 = -1;
-                    }
-                    else if (dealerValue > 21 && playerValue2 <= 21) {
-                        outcome2 = 1;
-                        p.adjustChips(bet2 * 2);
-                    }
-                    else if (playerValue2 > dealerValue && playerValue2 <= 21) {
-                        outcome2 = 1;
-                        p.adjustChips(bet2 * 2);
-                    }
-                    else if (playerValue2 < dealerValue && dealerValue <= 21) {
-                        outcome2 = -1;
-                    }
-                    else {
-                        outcome2 = 0;
-                        p.adjustChips(bet2);
-                    }
-                }
-
-                p.setRoundOutcomeSplit(outcome2);
-            }
-        }
-    }
-};
-
-
-// -------------- Decision Manager ----------------
-
-class BJDecisionManager {
-public:
-    static bool canAct(const BJPlayer& p, const BJGame& g) {
-        if (p.isBankrupt())
-            return false;
-        if (p.getID() != g.GetCurrentPlayer().getID())
-            return false;
-        return true;
-    }
-
-    static bool canHit(const BJPlayer& p, const BJGame& g) {
-        if (!canAct(p, g))
-            return false;
-
-        const BJHand& h = (g.getCurrentHandIndex() == 0 ? p.GetHand() : p.GetSplitHand());
-
-        if (h.value() >= 21)
-            return false;
-
-        if (g.getCurrentHandIndex() == 0)
-            return (p.getBet() > 0);
-        else
-            return (p.getSplitBet() > 0);
-    }
-
-    static bool canStand(const BJPlayer& p, const BJGame& g) {
-        if (!canAct(p, g))
-            return false;
-
-        const BJHand& h = (g.getCurrentHandIndex() == 0 ? p.GetHand() : p.GetSplitHand());
-
-        if (h.value() <= 0)
-            return false;
-
-        if (g.getCurrentHandIndex() == 0)
-            return (p.getBet() > 0);
-        else
-            return (p.getSplitBet() > 0);
-    }
-
-            static bool canDoubleDown(const BJPlayer& p, const BJGame& g) {
-        if (!canAct(p, g))
-            return false;
-
-        int handIndex = g.getCurrentHandIndex();
-		const BJHand& h =
-			(handIndex == 0 ? p.GetHand() : p.GetSplitHand());
-
-
-        if (p.hasActedOnHand(handIndex))
-            return false;
-
-
-        if (h.size() != 2)
-            return false;
-
-        int bet = (handIndex == 0 ? p.getBet() : p.getSplitBet());
-        if (bet <= 0)
-            return false;
-
-        return (p.getChips() >= bet);
-    }
-
-
-
-    static bool canSplit(const BJPlayer& p, const BJGame& g) {
-        if (!canAct(p, g))
-            return false;
-
-        if (g.getCurrentHandIndex() != 0)
-            return false;
-
-        if (p.hasSplitHand())
-            return false;
-
-        const BJHand& h = p.GetHand();
-        if (h.size() != 2)
-            return false;
-
-        const auto& cards = h.GetCards();
-        int r1 = static_cast<int>(cards[0].getRank());
-        int r2 = static_cast<int>(cards[1].getRank());
-
-        auto rankValue = [](int r) -> int {
-            if (r >= 11 && r <= 13) return 10;
-            return r;
-        };
-
-        if (rankValue(r1) != rankValue(r2))
-            return false;
-
-        int bet = p.getBet();
-        if (bet <= 0)
-            return false;
-        if (p.getChips() < bet)
-            return false;
-
-        return true;
-    }
-};
-
-
-
 //---------------------------------------------------------------------------
 // FORM IMPLEMENTATION
 //---------------------------------------------------------------------------
@@ -701,7 +77,10 @@ __fastcall TForm1::TForm1(TComponent* Owner)
       chipGlow(nullptr),
       collectingCards(false),
       collectCardIndex(0),
-      collectTimer(nullptr)
+      collectTimer(nullptr),
+      botTimer(nullptr),
+      botDealPending(false),
+      roundInPlay(false)
 {
 
     gameOverToMainMenu = false;
@@ -726,6 +105,11 @@ __fastcall TForm1::TForm1(TComponent* Owner)
     collectTimer->Interval = 80;
     collectTimer->OnTimer  = CollectTimerTick;
 
+    botTimer = new TTimer(this);
+    botTimer->Enabled  = false;
+    botTimer->Interval = 600;
+    botTimer->OnTimer  = BotTimerTick;
+
     dealingAnimationActive = false;
     dealPhase  = 0;
     dealIndex  = 0;
@@ -754,10 +138,21 @@ void __fastcall TForm1::FormHide(TObject *Sender)
 
 void TForm1::CreateGameInstance() {
     Settings& s = Settings::getInstance();
-    game = new BJGame(s.player_count, s.player_initial_chips);
+    game = new BJGame(s.player_count, s.player_initial_chips,
+                      s.deck_count, s.shoe_penetration, s.rules);
+    // a resumed table keeps its shoe, so the log starts from it
+    if (LoadSession())
+        roundLog.resume(*game, BJDealOrder::Table);
+    else
+        roundLog.start(*game, BJRandomSeed(), BJDealOrder::Table);
+    OpenHandHistory();
+    CreateSeatBots();
 }
 
 void TForm1::StartGame() {
+    gameOverToMainMenu = false;
+    roundInPlay        = false;
+
     if (!game) {
         CreateGameInstance();
     }
@@ -765,6 +160,11 @@ void TForm1::StartGame() {
     CreateDealerLabel();
     CreatePlayerLabels();
     CreateDeckImage();
+
+    if (AllSeatsBots() && Settings::getInstance().fast_bots) {
+        RunFastBotSession();
+        return;
+    }
     BeginBettingPhase();
 }
 
@@ -782,12 +182,143 @@ void TForm1::EndGame() {
         deckImage = nullptr;
     }
 
+    if (botTimer)
+        botTimer->Enabled = false;
+    botDealPending = false;
+    seatBots.clear();
+    bots.clear();
+
+    SaveRoundLog();
+    CloseHandHistory();
+    SaveSession();
+
     if (game) {
         delete game;
         game = nullptr;
     }
 }
 
+//---------------------------------------------------------------------------
+// BOT SEATS
+//---------------------------------------------------------------------------
+
+void TForm1::CreateSeatBots()
+{
+    Settings& s = Settings::getInstance();
+
+    bots.clear();
+    seatBots.assign(s.player_count, nullptr);
+
+    for (int i = 0; i < s.player_count && i < Settings::MaxPlayers; ++i) {
+        bots.push_back(BJMakeBot(s.seat_bots[i], s.rules, s.deck_count,
+                                 s.bot_unit_bet, BJRandomSeed() + i));
+        seatBots[i] = bots.back().get();
+    }
+
+    if (botTimer)
+        botTimer->Interval = s.fast_bots ? 1 : 600;
+}
+
+BJSeatController* TForm1::SeatBot(int playerIndex) const
+{
+    if (playerIndex < 0 || playerIndex >= (int)seatBots.size())
+        return nullptr;
+    return seatBots[playerIndex];
+}
+
+bool TForm1::AllSeatsBots() const
+{
+    if (seatBots.empty())
+        return false;
+    for (auto* bot : seatBots) {
+        if (!bot) return false;
+    }
+    return true;
+}
+
+// Plays the bot's choice through the same handlers as the buttons, so the
+// table animates it exactly like a click.
+void TForm1::PlayBotTurn()
+{
+    if (!game || bettingPhase) return;
+
+    BJSeatController* bot = SeatBot(game->getCurrentPlayerIndex());
+    if (!bot) return;
+
+    BJPlayer& p = game->GetCurrentPlayer();
+    BJAction  a = bot->decide(*game, p, game->GetCurrentHand());
+
+    if ((a == BJAction::Double    && !BJDecisionManager::canDoubleDown(p, *game)) ||
+        (a == BJAction::Split     && !BJDecisionManager::canSplit(p, *game)) ||
+        (a == BJAction::Surrender && !BJDecisionManager::canSurrender(p, *game)))
+    {
+        a = BJAction::Hit;
+    }
+
+    switch (a) {
+        case BJAction::Hit:
+            playerHit();
+            break;
+        case BJAction::Double:
+            playerDoubleDown();
+            break;
+        case BJAction::Split:
+            playerSplit();
+            break;
+        case BJAction::Surrender:
+            roundLog.action(*game, BJAction::Surrender);
+            if (eventRecorder)
+                eventRecorder->action(*game, BJAction::Surrender);
+            game->surrenderCurrentHand();
+            UpdateAllLabels();
+            playerStand();
+            break;
+        default:
+            playerStand();
+            break;
+    }
+}
+
+// Every seat is a bot and nobody is watching: play the whole session in
+// the engine and only show where it ended.
+void TForm1::RunFastBotSession()
+{
+    if (!game) return;
+
+    Settings& s = Settings::getInstance();
+
+    // the session deals in engine order, so its log starts afresh, from
+    // the shoe as it stands; its rounds are not put in the hand history
+    roundLog.resume(*game, BJDealOrder::Engine);
+    BJBotSession r = BJRunBotSession(*game, seatBots, s.goal_amount, s.bot_round_limit, &roundLog);
+
+    UpdateAllLabels();
+
+    if (r.goalReached || r.allBankrupt) {
+        EndRoundAndCheckGameOver();
+        return;
+    }
+
+    gameOverToMainMenu = true;
+    ShowGameOverBanner("Bots played " + IntToStr((int)r.rounds) + " rounds in " +
+                       FormatFloat("0.00", r.seconds) + " s");
+}
+
+void __fastcall TForm1::BotTimerTick(TObject *Sender)
+{
+    if (botTimer) botTimer->Enabled = false;
+    if (!game) return;
+
+    if (botDealPending) {
+        botDealPending = false;
+        if (bettingPhase)
+            DealButtonClick(nullptr);
+        return;
+    }
+
+    PlayBotTurn();
+}
+
 //---------------------------------------------------------------------------
 // BETTING PHASE
 //---------------------------------------------------------------------------
@@ -796,6 +327,8 @@ void TForm1::BeginBettingPhase()
 {
     if (!game) return;
 
+    SaveSession();
+
     bettingPhase     = true;
     dealerHoleHidden = false;
 
@@ -812,11 +345,25 @@ void TForm1::BeginBettingPhase()
         p.setSplitBet(0);
         p.setBet(0);
 
-        if (!p.isBankrupt() && bettingPlayerIndex == -1) {
+        if (!p.isBankrupt() && !SeatBot(i) && bettingPlayerIndex == -1) {
             bettingPlayerIndex = i;
         }
     }
 
+    // Bots bet straight away. The shoe is shuffled first if it is due, as
+    // the deal would, so a counting bot bets off the fresh count.
+    bool botsBet = false;
+    if (std::any_of(seatBots.begin(), seatBots.end(),
+                    [](BJSeatController* b) { return b != nullptr; })) {
+        if (game->GetShoe().needsReshuffle())
+            game->GetShoe().reshuffle();
+
+        botsBet = BJPlaceBotBets(*game, seatBots) > 0;
+        for (int i = 0; i < count; ++i) {
+            if (SeatBot(i)) playerBetConfirmed[i] = true;
+        }
+    }
+
     game->GetDealer().clearHand();
 
     ClearDealerCardImages();
@@ -853,6 +400,13 @@ void TForm1::BeginBettingPhase()
 	UpdateAllLabels();
 
     StartDeckShuffleAnimation();
+
+    // no human left to bet: deal the bots' round without waiting for a click
+    if (bettingPlayerIndex == -1 && botsBet) {
+        if (dealButton) dealButton->Enabled = true;
+        botDealPending = true;
+        if (botTimer) botTimer->Enabled = true;
+    }
 }
 
 
@@ -903,7 +457,7 @@ void TForm1::CreateDeckImage()
     deckImage->OnMouseLeave = DeckMouseLeave;
 
     try {
-        String folder = BJCard::GetCardsFolder();
+        String folder = BJCardAdapter::GetCardsFolder();
         deckImage->Bitmap->LoadFromFile(folder + "back.png");
     } catch (...) {}
 
@@ -1252,7 +806,7 @@ void TForm1::DrawDealerCards() {
     int dealerValue = h.value();
     bool dealerIs21 = (dealerValue == 21 && !dealerHoleHidden);
 
-    String folder = BJCard::GetCardsFolder();
+    String folder = BJCardAdapter::GetCardsFolder();
     int count = (int)cards.size();
 
     const float cardW = 120.f;
@@ -1271,7 +825,7 @@ void TForm1::DrawDealerCards() {
             if (dealerHoleHidden && i == 1) {
                 img->Bitmap->LoadFromFile(folder + "back.png");
             } else {
-                img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(cards[i]));
+                img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(cards[i]));
             }
         }
         catch (...) {}
@@ -1312,26 +866,21 @@ bool TForm1::CheckDealerBlackjack()
     const auto& cards = dh.GetCards();
     if (cards.size() < 2) return false;
 
-    const BJCard& up = cards[0];
-
-    int upRank = static_cast<int>(up.getRank());
-    bool upIsTenLike =
-        (upRank == static_cast<int>(BJRank::R10)) ||
-        (upRank == static_cast<int>(BJRank::RJ))  ||
-        (upRank == static_cast<int>(BJRank::RQ))  ||
-        (upRank == static_cast<int>(BJRank::RK));
-    bool upIsAce = (upRank == static_cast<int>(BJRank::RA));
-
-    if (!upIsTenLike && !upIsAce)
+    if (!game->dealerShouldPeek())
         return false;
 
-    bool isBlackjack = (dh.value() == 21);
+    bool isBlackjack = dh.isBlackjack();
 
     if (dealerCardImages.size() < 2 || dealerCardImages[1] == nullptr) {
         if (isBlackjack) {
             dealerHoleHidden = false;
             UpdateAllLabels();
             game->settleBets();
+            roundLog.endRound(*game, false);
+            if (eventRecorder)
+                eventRecorder->endRound(*game, false);
+            roundInPlay = false;
+            SaveSession();
             ShowRoundOverOverlay();
         }
         return isBlackjack;
@@ -1374,7 +923,7 @@ void TForm1::DrawPlayerCards()
 
     float extraPlayerSpacing = 40.f;
 
-    String folder = BJCard::GetCardsFolder();
+    String folder = BJCardAdapter::GetCardsFolder();
 
     for (int i = 0; i < playerCount; ++i) {
         BJPlayer& p  = game->GetPlayer(i);
@@ -1434,7 +983,7 @@ void TForm1::DrawPlayerCards()
                     img->WrapMode    = TImageWrapMode::Fit;
 
                     try {
-                        img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(mainCards[c]));
+                        img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(mainCards[c]));
                     } catch (...) {}
 
                     img->BringToFront();
@@ -1473,7 +1022,7 @@ void TForm1::DrawPlayerCards()
                     img->WrapMode    = TImageWrapMode::Fit;
 
                     try {
-                        img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(mainCards[c]));
+                        img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(mainCards[c]));
                     } catch (...) {}
 
                     img->BringToFront();
@@ -1511,7 +1060,7 @@ void TForm1::DrawPlayerCards()
                     img->WrapMode    = TImageWrapMode::Fit;
 
                     try {
-                        img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(splitCards[c]));
+                        img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(splitCards[c]));
                     } catch (...) {}
 
                     img->BringToFront();
@@ -1633,8 +1182,8 @@ void TForm1::AnimateDealtCardToPlayer(int playerIndex)
     img->WrapMode    = TImageWrapMode::Fit;
 
     try {
-        String folder = BJCard::GetCardsFolder();
-        img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(cards[cardIndex]));
+        String folder = BJCardAdapter::GetCardsFolder();
+        img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(cards[cardIndex]));
     } catch (...) {}
 
     img->BringToFront();
@@ -1700,11 +1249,11 @@ void TForm1::AnimateDealtCardToDealer()
     img->WrapMode    = TImageWrapMode::Fit;
 
     try {
-        String folder = BJCard::GetCardsFolder();
+        String folder = BJCardAdapter::GetCardsFolder();
         if (dealerHoleHidden && cardIndex == 1) {
             img->Bitmap->LoadFromFile(folder + "back.png");
         } else {
-            img->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(cards[cardIndex]));
+            img->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(cards[cardIndex]));
         }
     } catch (...) {}
 
@@ -1792,7 +1341,7 @@ void TForm1::AnimateHitToCurrentHand()
     float deckX, deckY;
     GetDeckPosition(deckImage, deckX, deckY);
 
-    String folder = BJCard::GetCardsFolder();
+    String folder = BJCardAdapter::GetCardsFolder();
 
     TImage* animImg = new TImage(nullptr);
     animImg->Parent = this;
@@ -1803,7 +1352,7 @@ void TForm1::AnimateHitToCurrentHand()
     animImg->Position->Y = deckY;
 
     try {
-        animImg->Bitmap->LoadFromFile(folder + BJCard::GetCardFileName(cards[cardIndex]));
+        animImg->Bitmap->LoadFromFile(folder + BJCardAdapter::GetCardFileName(cards[cardIndex]));
     }
     catch (...) {}
 
@@ -1895,6 +1444,11 @@ void __fastcall TForm1::DealerPeekRotateFinished(TObject* Sender)
     dealerHoleHidden = false;
     UpdateAllLabels();
     game->settleBets();
+    roundLog.endRound(*game, false);
+    if (eventRecorder)
+        eventRecorder->endRound(*game, false);
+    roundInPlay = false;
+    SaveSession();
     ShowRoundOverOverlay();
 }
 
@@ -2035,7 +1589,7 @@ void TForm1::CreateShuffleCards()
 
     if (!deckImage) return;
 
-    String folder = BJCard::GetCardsFolder();
+    String folder = BJCardAdapter::GetCardsFolder();
 
     const int   count = 4;
     const float cardW = 90.f;
@@ -2191,35 +1745,18 @@ void TForm1::CreatePlayerActionButtons()
         return;
     }
 
+    // bots get no buttons; they act off the bot timer
+    if (SeatBot(playerIndex)) {
+        if (botTimer) botTimer->Enabled = true;
+        return;
+    }
+
     // ---------- RULE LOGIC ----------
 
     bool canHit    = (total < 21);
     bool canStand  = true;
-    bool canSplit  = false;
-    bool canDouble = false;
-
-    bool alreadyActed = p.hasActedOnHand(handIndex);
-
-
-    if (handIndex == 0 && !p.hasSplitHand() && cards.size() == 2 && !alreadyActed)
-    {
-        int r1 = static_cast<int>(cards[0].getRank());
-        int r2 = static_cast<int>(cards[1].getRank());
-
-        if (r1 == r2 && p.getChips() >= betForThisHand)
-        {
-            canSplit = true;
-        }
-    }
-
-
-    if (!alreadyActed &&
-        cards.size() == 2 &&
-        total >= 9 && total <= 11 &&
-        p.getChips() >= betForThisHand)
-    {
-        canDouble = true;
-    }
+    bool canSplit  = BJDecisionManager::canSplit(p, *game);
+    bool canDouble = BJDecisionManager::canDoubleDown(p, *game);
 
     // ---------- CREATE / LAYOUT BUTTONS ----------
 
@@ -2578,7 +2115,7 @@ void TForm1::CreateBetConfirmButtons()
         btn->OnClick = BetConfirmButtonClick;
 
         BJPlayer& p = game->GetPlayer(i);
-        if (p.isBankrupt()) {
+        if (p.isBankrupt() || SeatBot(i)) {
             btn->Enabled = false;
         }
 
@@ -2721,6 +2258,11 @@ void TForm1::StartDealingAnimation()
 {
     if (!game) return;
 
+    roundLog.beginRound(*game);
+    if (eventRecorder)
+        eventRecorder->beginRound(*game);
+    roundInPlay = true;
+    SaveSession();
     game->resetForNextRound();
 
     dealingAnimationActive = true;
@@ -2758,7 +2300,7 @@ void __fastcall TForm1::DealTimerTick(TObject *Sender)
             if (dealIndex < playerCount) {
                 int idx = dealIndex;
                 BJPlayer &p = game->GetPlayer(idx);
-                game->GetDeck().dealCardTo(p.GetHand());
+                game->GetShoe().dealCardTo(p.GetHand());
 
                 AnimateDealtCardToPlayer(idx);
                 ++dealIndex;
@@ -2773,7 +2315,7 @@ void __fastcall TForm1::DealTimerTick(TObject *Sender)
 
         case 1:
         {
-            game->GetDeck().dealCardTo(game->GetDealer().GetHand());
+            game->GetShoe().dealCardTo(game->GetDealer().GetHand());
             AnimateDealtCardToDealer();
             UpdateAllLabels();
             dealPhase = 2;
@@ -2786,7 +2328,7 @@ void __fastcall TForm1::DealTimerTick(TObject *Sender)
             if (dealIndex < playerCount) {
                 int idx = dealIndex;
                 BJPlayer &p = game->GetPlayer(idx);
-                game->GetDeck().dealCardTo(p.GetHand());
+                game->GetShoe().dealCardTo(p.GetHand());
 
                 AnimateDealtCardToPlayer(idx);
                 ++dealIndex;
@@ -2801,7 +2343,7 @@ void __fastcall TForm1::DealTimerTick(TObject *Sender)
 
         case 3:
         {
-            game->GetDeck().dealCardTo(game->GetDealer().GetHand());
+            game->GetShoe().dealCardTo(game->GetDealer().GetHand());
 
             AnimateDealtCardToDealer();
 
@@ -3042,7 +2584,7 @@ void TForm1::StartCollectCardsAnimation()
         return;
     }
 
-    String folder = BJCard::GetCardsFolder();
+    String folder = BJCardAdapter::GetCardsFolder();
     for (auto* img : collectImages) {
         try {
             img->Bitmap->LoadFromFile(folder + "back.png");
@@ -3225,6 +2767,9 @@ bool TForm1::CheckGoalWinners(String &outText)
 
 void TForm1::ShowGameOverBanner(const String& text)
 {
+    // a finished game leaves nothing to resume
+    ClearSession();
+
     if (!roundOverPanel) {
         roundOverPanel = new TRectangle(this);
         roundOverPanel->Parent = this;
@@ -3435,13 +2980,10 @@ void __fastcall TForm1::SplitButtonClick(TObject* Sender) { playerSplit(); }
 void TForm1::playerHit() {
     if (!game || bettingPhase) return;
 
-    BJPlayer& p = game->GetCurrentPlayer();
-    BJHand&   h = game->GetCurrentHand();
-
-    game->GetDeck().dealCardTo(h);
-
-    // mark that this hand has acted
-    p.markActionOnHand(game->getCurrentHandIndex());
+    roundLog.action(*game, BJAction::Hit);
+    if (eventRecorder)
+        eventRecorder->action(*game, BJAction::Hit);
+    game->hitCurrentHand();
 
     AnimateHitToCurrentHand();
 }
@@ -3449,13 +2991,10 @@ void TForm1::playerHit() {
 void TForm1::playerStand() {
     if (!game || bettingPhase) return;
 
-    BJPlayer& p = game->GetCurrentPlayer();
-    int handIndex = game->getCurrentHandIndex();
-
-    // mark that this hand has acted
-    p.markActionOnHand(handIndex);
-
-    if (game->advanceTurn()) {
+    roundLog.action(*game, BJAction::Stand);
+    if (eventRecorder)
+        eventRecorder->action(*game, BJAction::Stand);
+    if (game->standCurrentHand()) {
         UpdateAllLabels();
         CreatePlayerActionButtons();
         return;
@@ -3464,6 +3003,11 @@ void TForm1::playerStand() {
     dealerHoleHidden = false;
     game->resolveDealerHand();
     game->settleBets();
+    roundLog.endRound(*game, true);
+    if (eventRecorder)
+        eventRecorder->endRound(*game, true);
+    roundInPlay = false;
+    SaveSession();
 
     UpdateAllLabels();
     ShowRoundOverOverlay();
@@ -3473,21 +3017,17 @@ void TForm1::playerDoubleDown() {
     if (!game || bettingPhase) return;
 
     BJPlayer& p = game->GetCurrentPlayer();
-    BJHand&   h = game->GetCurrentHand();
     int handIndex = game->getCurrentHandIndex();
 
-    int bet = (handIndex == 0 ? p.getBet() : p.getSplitBet());
-    if (bet > 0 && p.getChips() >= bet && !p.hasActedOnHand(handIndex)) {
-        p.adjustChips(-bet);
-
-        if (handIndex == 0)
-            p.setBet(bet * 2);
-        else
-            p.setSplitBet(bet * 2);
-
-        p.markActionOnHand(handIndex);
+    bool doubled = false;
+    if (!p.hasActedOnHand(handIndex)) {
+        roundLog.action(*game, BJAction::Double);
+        if (eventRecorder)
+            eventRecorder->action(*game, BJAction::Double);
+        doubled = game->doubleCurrentHand();
+    }
 
-        game->GetDeck().dealCardTo(h);
+    if (doubled) {
         UpdateAllLabels();
         playerStand();
     } else {
@@ -3505,43 +3045,156 @@ void TForm1::playerSplit() {
         return;
     }
 
-    BJHand& h = p.GetHand();
-    const auto& cards = h.GetCards();
-    if (cards.size() != 2) {
+    if (p.GetHand().size() != 2) {
         ShowMessage("Split only works on exactly two cards.");
         return;
     }
 
-    BJCard c1 = cards[0];
-    BJCard c2 = cards[1];
+    roundLog.action(*game, BJAction::Split);
+    if (eventRecorder)
+        eventRecorder->action(*game, BJAction::Split);
+    if (!game->splitCurrentHand()) {
+        ShowMessage("Not enough chips to split.");
+        return;
+    }
 
-    h.clear();
-    h.addCard(c1);
+    DestroyPlayerActionButtons();
+    AnimateSplitForCurrentHand();
+}
 
-    BJHand& sh = p.GetSplitHand();
-    sh.clear();
-    sh.addCard(c2);
-    p.setHasSplit(true);
 
-    int bet = p.getBet();
-    if (bet > 0 && p.getChips() >= bet) {
-        p.adjustChips(-bet);
-        p.setSplitBet(bet);
-    } else {
-        p.setHasSplit(false);
-        sh.clear();
-        ShowMessage("Not enough chips to split.");
+// Keeps the last session's rounds for bjreplay. Leaving the table never
+// fails on account of the log.
+void TForm1::SaveRoundLog()
+{
+    if (!Settings::getInstance().save_round_log || roundLog.getRoundCount() == 0)
         return;
+
+    try {
+        String path = System::Ioutils::TPath::Combine(
+            System::Ioutils::TPath::GetDocumentsPath(), "Blackwater-rounds.bjrl");
+        std::ofstream out(AnsiString(path).c_str(), std::ios::binary);
+        if (out)
+            BJWriteRoundLog(out, roundLog);
+    } catch (...) {
     }
+}
 
-	// mark both hands as having acted, so no double down afterward
-    p.markActionOnHand(0);
-    p.markActionOnHand(1);
+// Starts this session's hand history, replacing the last one. The table
+// logs on a dropping channel, so a slow disk costs rounds from the archive,
+// never a stall at the table.
+void TForm1::OpenHandHistory()
+{
+    if (!Settings::getInstance().save_hand_history || !game)
+        return;
 
-    DestroyPlayerActionButtons();
-    AnimateSplitForCurrentHand();
+    try {
+        String path = System::Ioutils::TPath::Combine(
+            System::Ioutils::TPath::GetDocumentsPath(), "Blackwater-history.bjh");
+        historyOut.open(AnsiString(path).c_str(), std::ios::binary | std::ios::trunc);
+        if (!historyOut)
+            return;
+        historyWriter.reset(new BJHandHistoryWriter(historyOut, BJRuntimeRules::from(game->GetRules())));
+        historySink.reset(new BJHistoryEventSink(*historyWriter));
+        eventLog.reset(new BJEventLog(std::ref(*historySink)));
+        eventRecorder.reset(new BJEventRecorder(eventLog->openChannel(BJEventOverflow::Drop)));
+    } catch (...) {
+        CloseHandHistory();
+    }
+}
+
+// Lets the writer thread catch up and closes the archive. Leaving the
+// table never fails on account of it.
+void TForm1::CloseHandHistory()
+{
+    eventRecorder.reset();
+    try {
+        if (eventLog)
+            eventLog->stop();
+    } catch (...) {
+    }
+    eventLog.reset();
+    historySink.reset();
+    try {
+        if (historyWriter)
+            historyWriter->close();
+    } catch (...) {
+    }
+    historyWriter.reset();
+    if (historyOut.is_open())
+        historyOut.close();
+    historyOut.clear();
+}
+
+static String SessionPath()
+{
+    return System::Ioutils::TPath::Combine(
+        System::Ioutils::TPath::GetDocumentsPath(), "Blackwater-session.bjss");
+}
+
+// Keeps the table for the next start: after every settled round, as the
+// cards go out (so a crash mid-round voids it) and on leaving. The file is
+// written beside the old one and swapped in whole. Never fails the game.
+void TForm1::SaveSession()
+{
+    if (!game || !Settings::getInstance().resume_session)
+        return;
+    if (gameOverToMainMenu) {
+        ClearSession();
+        return;
+    }
+
+    const BJSnapshotPoint at = roundInPlay  ? BJSnapshotPoint::MidRound
+                             : bettingPhase ? BJSnapshotPoint::Betting
+                             :                BJSnapshotPoint::BetweenRounds;
+    try {
+        const String path = SessionPath();
+        const String temp = path + ".tmp";
+        {
+            std::ofstream out(AnsiString(temp).c_str(), std::ios::binary | std::ios::trunc);
+            if (!out)
+                return;
+            BJWriteSnapshot(out, BJTakeSnapshot(*game, at));
+        }
+        if (System::Ioutils::TFile::Exists(path))
+            System::Ioutils::TFile::Delete(path);
+        System::Ioutils::TFile::Move(temp, path);
+    } catch (...) {
+    }
+}
+
+// Puts the last session's table on the new game when it had the same
+// seats; the copy left beside it stands in if a save was cut short. A
+// missing or damaged file just means a fresh table.
+bool TForm1::LoadSession()
+{
+    if (!game || !Settings::getInstance().resume_session)
+        return false;
+
+    const String path = SessionPath();
+    const String files[2] = { path, path + ".tmp" };
+    for (const String& f : files) {
+        try {
+            std::ifstream in(AnsiString(f).c_str(), std::ios::binary);
+            if (in && BJRestoreSnapshot(*game, BJReadSnapshot(in)))
+                return true;
+        } catch (...) {
+        }
+    }
+    return false;
 }
 
+void TForm1::ClearSession()
+{
+    try {
+        const String path = SessionPath();
+        if (System::Ioutils::TFile::Exists(path))
+            System::Ioutils::TFile::Delete(path);
+        if (System::Ioutils::TFile::Exists(path + ".tmp"))
+            System::Ioutils::TFile::Delete(path + ".tmp");
+    } catch (...) {
+    }
+}
 
 //---------------------------------------------------------------------------
 // FORM CLOSE
@@ -3549,6 +3202,7 @@ void TForm1::playerSplit() {
 
 void __fastcall TForm1::FormClose(TObject *Sender, TCloseAction &Action)
 {
+	SaveSession();
 	Application->Terminate();
 	Action = TCloseAction::caFree;
 }
@@ -3657,7 +3311,7 @@ void TForm1::UpdateAllLabels()
         if (dealerHoleHidden && cards.size() >= 2)
             points = "?";
         else
-            points = DescribePoints(dh);
+            points = BJCardAdapter::DescribePoints(dh);
 
         dealerLabel->Text = "Dealer\r\nPoints: " + points;
 
@@ -3769,7 +3423,7 @@ void TForm1::UpdateAllLabels()
             info->TextSettings->HorzAlign    = TTextAlign::Center;
 
             info->Text =
-                "Points: " + DescribePoints(h) +
+                "Points: " + BJCardAdapter::DescribePoints(h) +
                 "\nBet: $" + IntToStr(p.getBet());
 
             int val = h.value();
@@ -3831,7 +3485,7 @@ void TForm1::UpdateAllLabels()
             info2->TextSettings->HorzAlign    = TTextAlign::Center;
 
             info2->Text =
-                "Points: " + DescribePoints(sh2) +
+                "Points: " + BJCardAdapter::DescribePoints(sh2) +
                 "\nBet: $" + IntToStr(p.getSplitBet());
 
             int val2      = sh2.value();
@@ -13,17 +13,61 @@
 #include <FMX.Ani.hpp>
 #include <FMX.Effects.hpp>
 
+#include <cstdint>
+#include <fstream>
+#include <memory>
 #include <vector>
 
+#include "engine/BJBots.h"
+#include "engine/BJEventLog.h"
+#include "engine/BJReplay.h"
+#include "engine/BJRules.h"
+#include "engine/BJSnapshot.h"
+
 class TFormMainMenu;
 extern PACKAGE TFormMainMenu *FormMainMenu;
 
 class Settings {
 public:
+    static constexpr int MaxPlayers = 4;
+
     int player_count         = 1;
     int player_initial_chips = 500;
     int goal_amount          = 1000;
 
+    // Shoe: 1-8 decks, reshuffled once this fraction has been dealt.
+    int    deck_count       = 6;
+    double shoe_penetration = 0.75;
+
+    // Table rules; the defaults are the game's original ones (S17, no DAS,
+    // double on 9-11, one split, 3:2, dealer peeks).
+    BJRuntimeRules rules;
+
+    // Seats a built-in bot plays instead of the buttons, betting in units
+    // of bot_unit_bet. When every seat is a bot and fast_bots is set, the
+    // session plays out in the engine without animations, for at most
+    // bot_round_limit rounds.
+    BJBotKind     seat_bots[MaxPlayers] = {};
+    int           bot_unit_bet          = 10;
+    bool          fast_bots             = false;
+    std::uint64_t bot_round_limit       = 1000000;
+
+    // Every round of a session is logged (shoe seed, bets, each action) and
+    // the log is saved to the documents folder on leaving the table, so
+    // bjreplay can rebuild any round exactly.
+    bool save_round_log = true;
+
+    // Every dealt round is also archived card by card to a hand history in
+    // the documents folder, for bjhistory. The table hands its events to a
+    // writer thread and never waits on it; a round lost to a full queue is
+    // just missing from the archive.
+    bool save_hand_history = true;
+
+    // The table (chips, bankrupt seats, the shoe) is saved to the documents
+    // folder after every round and on leaving, and the next game with the
+    // same seats carries on from it. A round cut off mid-play is void.
+    bool resume_session = true;
+
     static Settings& getInstance() {
         static Settings instance;
         return instance;
@@ -35,8 +79,6 @@ private:
     Settings& operator=(const Settings&) = delete;
 };
 
-class BJGame;
-
 //---------------------------------------------------------------------------
 
 class TForm1 : public TForm
@@ -182,6 +224,42 @@ private:
     void __fastcall DeckMouseEnter(TObject *Sender);
     void __fastcall DeckMouseLeave(TObject *Sender);
 
+    // Bot seats: controllers from Settings::seat_bots, null for humans.
+    std::vector<std::unique_ptr<BJSeatController>> bots;
+    std::vector<BJSeatController*>                 seatBots;
+    TTimer*                                        botTimer;
+    bool                                           botDealPending;
+
+    void CreateSeatBots();
+    BJSeatController* SeatBot(int playerIndex) const;
+    bool AllSeatsBots() const;
+    void PlayBotTurn();
+    void RunFastBotSession();
+    void __fastcall BotTimerTick(TObject *Sender);
+
+    // This session's rounds, from the shoe's seed on.
+    BJRoundLog roundLog;
+
+    void SaveRoundLog();
+
+    // The hand history of this session's dealt rounds; off when the
+    // archive could not be opened.
+    std::ofstream                        historyOut;
+    std::unique_ptr<BJHandHistoryWriter> historyWriter;
+    std::unique_ptr<BJHistoryEventSink>  historySink;
+    std::unique_ptr<BJEventLog>          eventLog;
+    std::unique_ptr<BJEventRecorder>     eventRecorder;
+
+    void OpenHandHistory();
+    void CloseHandHistory();
+
+    // Cards are out and the round is not settled yet.
+    bool roundInPlay;
+
+    void SaveSession();
+    bool LoadSession();
+    void ClearSession();
+
     void StartDealingAnimation();
     void __fastcall DealTimerTick(TObject *Sender);
 
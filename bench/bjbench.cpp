@@ -0,0 +1,270 @@
+//---------------------------------------------------------------------------
+// bjbench: Google Benchmark microbenchmarks for the engine hot paths.
+//
+//   bjbench [--benchmark_filter=REGEX] [--benchmark_format=json] ...
+//
+// Every benchmark shuffles from a fixed seed, so two builds time the same
+// work; compare runs with Google Benchmark's tools/compare.py on the JSON
+// the bench_json target writes.
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BJEngine.h"
+#include "BJBasicStrategyApp.h"
+#include "BJHandBatch.h"
+#include "BJStrategies.h"
+
+static const std::uint64_t kSeed = 20240601;
+
+typedef BJBasicGame<BJRulesS17> BJGameS17;
+
+// ---------------- HAND ----------------
+
+// 1024 hands of two to five cards from a shuffled shoe.
+static std::vector<BJHand> MakeHands()
+{
+    BJShoe shoe(6, 0.75, kSeed);
+    std::vector<BJHand> hands(1024);
+    for (std::size_t i = 0; i < hands.size(); ++i) {
+        const int n = 2 + (int)(i % 4);
+        for (int c = 0; c < n; ++c) {
+            if (shoe.needsReshuffle())
+                shoe.reshuffle();
+            hands[i].addCard(shoe.DrawCard());
+        }
+    }
+    return hands;
+}
+
+static void BM_HandValue(benchmark::State& state)
+{
+    const std::vector<BJHand> hands = MakeHands();
+    for (auto _ : state) {
+        int sum = 0;
+        for (const auto& h : hands)
+            sum += h.value();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (std::int64_t)hands.size());
+}
+BENCHMARK(BM_HandValue);
+
+// The same hands through BJHandBatch at each SIMD level this CPU has.
+static void BM_HandBatchValues(benchmark::State& state)
+{
+    const BJSimdLevel level = (BJSimdLevel)state.range(0);
+    if ((int)level > (int)BJBestSimdLevel()) {
+        state.SkipWithError("SIMD level not supported here");
+        return;
+    }
+
+    const std::vector<BJHand> hands = MakeHands();
+    BJHandBatch batch((int)hands.size(), level);
+    for (int i = 0; i < batch.size(); ++i)
+        batch.set(i, hands[i]);
+
+    std::vector<std::uint8_t> out(hands.size());
+    for (auto _ : state) {
+        batch.values(out.data());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (std::int64_t)hands.size());
+    state.SetLabel(BJSimdLevelName(level));
+}
+BENCHMARK(BM_HandBatchValues)->DenseRange(0, (int)BJSimdLevel::Count - 1);
+
+// ---------------- SHOE ----------------
+
+static void BM_ShoeShuffle(benchmark::State& state)
+{
+    BJShoe shoe((int)state.range(0), 0.75, kSeed);
+    for (auto _ : state) {
+        shoe.reshuffle();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * shoe.size());
+}
+BENCHMARK(BM_ShoeShuffle)->Arg(1)->Arg(6)->Arg(8);
+
+// Deals down to the cut card per iteration; the reshuffle is not timed.
+static void BM_DrawCard(benchmark::State& state)
+{
+    BJShoe shoe((int)state.range(0), 0.75, kSeed);
+    std::int64_t draws = 0;
+    for (auto _ : state) {
+        while (!shoe.needsReshuffle()) {
+            benchmark::DoNotOptimize(shoe.DrawCard());
+            ++draws;
+        }
+        state.PauseTiming();
+        shoe.reshuffle();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(draws);
+}
+BENCHMARK(BM_DrawCard)->Arg(1)->Arg(6);
+
+// ---------------- GAME ----------------
+
+template <class Game>
+static void PlaceBets(Game& g, int bet = 10)
+{
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        BJPlayer& p = g.GetPlayer(i);
+        p.setBet(bet);
+        p.setSplitBet(0);
+    }
+}
+
+// Deal of a new round for 1-4 players: collect, reshuffle when due, deal.
+static void BM_StartRound(benchmark::State& state)
+{
+    BJGame game((int)state.range(0), 1 << 30, 6, 0.75);
+    game.GetShoe().seed(kSeed);
+    PlaceBets(game);
+
+    for (auto _ : state) {
+        game.startRound();
+        benchmark::DoNotOptimize(game.GetDealer().GetHand().value());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StartRound)->DenseRange(1, 4);
+
+// Settlement of a dealt round; chips are put back after each pass so every
+// iteration settles the same hands.
+static void BM_SettleBets(benchmark::State& state)
+{
+    const int players = (int)state.range(0);
+    BJGame game(players, 1000, 6, 0.75);
+    game.GetShoe().seed(kSeed);
+    PlaceBets(game);
+    game.startRound();
+    game.resolveDealerHand();
+
+    for (auto _ : state) {
+        game.settleBets();
+        for (int i = 0; i < players; ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(1000 - p.getChips());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * players);
+}
+BENCHMARK(BM_SettleBets)->DenseRange(1, 4);
+
+// ---------------- DECISION MANAGER ----------------
+
+// One seat holding 8-8 against a 6, so every predicate runs its full set
+// of checks before answering.
+struct PairFixture {
+    BJGame game;
+
+    PairFixture() : game(1, 1000, 6, 0.75) {
+        PlaceBets(game);
+        game.resetForNextRound();
+        BJHand& h = game.GetPlayer(0).GetHand();
+        h.addCard(BJCard(BJSuit::SuitSpade, BJRank::R8));
+        h.addCard(BJCard(BJSuit::SuitHeart, BJRank::R8));
+        BJHand& d = game.GetDealer().GetHand();
+        d.addCard(BJCard(BJSuit::SuitClub,    BJRank::R6));
+        d.addCard(BJCard(BJSuit::SuitDiamond, BJRank::RK));
+    }
+};
+
+static void BM_CanDoubleDown(benchmark::State& state)
+{
+    PairFixture f;
+    const BJPlayer& p = f.game.GetPlayer(0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BJDecisionManager::canDoubleDown(p, f.game));
+}
+BENCHMARK(BM_CanDoubleDown);
+
+static void BM_CanSplit(benchmark::State& state)
+{
+    PairFixture f;
+    const BJPlayer& p = f.game.GetPlayer(0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BJDecisionManager::canSplit(p, f.game));
+}
+BENCHMARK(BM_CanSplit);
+
+static void BM_CanSurrender(benchmark::State& state)
+{
+    PairFixture f;
+    const BJPlayer& p = f.game.GetPlayer(0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BJDecisionManager::canSurrender(p, f.game));
+}
+BENCHMARK(BM_CanSurrender);
+
+static void BM_CanHitStand(benchmark::State& state)
+{
+    PairFixture f;
+    const BJPlayer& p = f.game.GetPlayer(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BJDecisionManager::canHit(p, f.game));
+        benchmark::DoNotOptimize(BJDecisionManager::canStand(p, f.game));
+    }
+}
+BENCHMARK(BM_CanHitStand);
+
+// ---------------- FULL ROUNDS ----------------
+
+// Basic strategy, but splits every pair it is allowed to, so the split
+// paths (second hand, resplit checks, two settlements) are always hot.
+struct SplitEveryPairStrategy {
+    BJBasicStrategy basic;
+
+    template <class Game>
+    BJAction decide(const Game& g, const BJPlayer& p, const BJHand& h) const {
+        return BJDecisionManager::canSplit(p, g) ? BJAction::Split : basic.decide(g, p, h);
+    }
+};
+
+// Whole rounds through BJPlayRound, as the simulator plays them: bet,
+// deal, peek, decisions, dealer, settlement.
+template <class Game, class Strategy>
+static void FullRounds(benchmark::State& state, Strategy strategy)
+{
+    const int players = (int)state.range(0);
+    Game game(players, 1000, 6, 0.75);
+    game.GetShoe().seed(kSeed);
+
+    for (auto _ : state) {
+        for (int i = 0; i < players; ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(1000 - 10 - p.getChips());
+            p.setBet(10);
+            p.setSplitBet(0);
+        }
+        BJPlayRound(game, strategy);
+    }
+    state.SetItemsProcessed(state.iterations() * players);
+}
+
+static void BM_FullRound(benchmark::State& state)
+{
+    FullRounds<BJGameS17>(state, BJBasicStrategy());
+}
+BENCHMARK(BM_FullRound)->DenseRange(1, 4);
+
+static void BM_FullRoundApp(benchmark::State& state)
+{
+    FullRounds<BJGame>(state, BJBasicStrategy(BJBasicStrategyApp));
+}
+BENCHMARK(BM_FullRoundApp)->DenseRange(1, 4);
+
+static void BM_FullRoundSplits(benchmark::State& state)
+{
+    FullRounds<BJGameS17>(state, SplitEveryPairStrategy());
+}
+BENCHMARK(BM_FullRoundSplits)->DenseRange(1, 4);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+#ifndef BJBasicStrategyAppH
+#define BJBasicStrategyAppH
+//---------------------------------------------------------------------------
+
+// Generated by tools/bjstrategy; do not edit by hand.
+
+#include "BJStrategyTable.h"
+
+// 6 decks, S17, no DAS, double 9-11, peek, blackjack pays 3:2
+inline constexpr BJStrategyTable BJBasicStrategyApp = {
+    {   // hard
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "HHHHHHHHHH",   // 1
+        "HHHHHHHHHH",   // 2
+        "HHHHHHHHHH",   // 3
+        "HHHHHHHHHH",   // 4
+        "HHHHHHHHHH",   // 5
+        "HHHHHHHHHH",   // 6
+        "HHHHHHHHHH",   // 7
+        "HHHHHHHHHH",   // 8
+        "HDDDDHHHHH",   // 9
+        "DDDDDDDDHH",   // 10
+        "DDDDDDDDDH",   // 11
+        "HHSSSHHHHH",   // 12
+        "SSSSSHHHHH",   // 13
+        "SSSSSHHHHH",   // 14
+        "SSSSSHHHHH",   // 15
+        "SSSSSHHHHH",   // 16
+        "SSSSSSSSSS",   // 17
+        "SSSSSSSSSS",   // 18
+        "SSSSSSSSSS",   // 19
+        "SSSSSSSSSS",   // 20
+        "SSSSSSSSSS",   // 21
+    },
+    {   // soft
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "HHHHHHHHHH",   // 1
+        "HHHHHHHHHH",   // 2
+        "HHHHHHHHHH",   // 3
+        "HHHHHHHHHH",   // 4
+        "HHHHHHHHHH",   // 5
+        "HHHHHHHHHH",   // 6
+        "HHHHHHHHHH",   // 7
+        "HHHHHHHHHH",   // 8
+        "HHHHHHHHHH",   // 9
+        "HHHHHHHHHH",   // 10
+        "HHHHHHHHHH",   // 11
+        "HHHHHHHHHH",   // 12
+        "HHHHHHHHHH",   // 13
+        "HHHHHHHHHH",   // 14
+        "HHHHHHHHHH",   // 15
+        "HHHHHHHHHH",   // 16
+        "HHHHHHHHHH",   // 17
+        "SSSSSSSHHH",   // 18
+        "SSSSSSSSSS",   // 19
+        "SSSSSSSSSS",   // 20
+        "SSSSSSSSSS",   // 21
+    },
+    {   // pair
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "PPPPPPPPPP",   // 1
+        "HHPPPPHHHH",   // 2
+        "HHPPPPHHHH",   // 3
+        "HHHHHHHHHH",   // 4
+        "DDDDDDDDHH",   // 5
+        "HPPPPHHHHH",   // 6
+        "PPPPPPHHHH",   // 7
+        "PPPPPPPPPP",   // 8
+        "PPPPPSPPSS",   // 9
+        "SSSSSSSSSS",   // 10
+    },
+};
+
+//---------------------------------------------------------------------------
+#endif
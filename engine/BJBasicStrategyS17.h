@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+#ifndef BJBasicStrategyS17H
+#define BJBasicStrategyS17H
+//---------------------------------------------------------------------------
+
+// Generated by tools/bjstrategy; do not edit by hand.
+
+#include "BJStrategyTable.h"
+
+// 6 decks, S17, DAS, double any two, late surrender, peek, blackjack pays 3:2
+inline constexpr BJStrategyTable BJBasicStrategyS17 = {
+    {   // hard
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "HHHHHHHHHH",   // 1
+        "HHHHHHHHHH",   // 2
+        "HHHHHHHHHH",   // 3
+        "HHHHHHHHHH",   // 4
+        "HHHHHHHHHH",   // 5
+        "HHHHHHHHHH",   // 6
+        "HHHHHHHHHH",   // 7
+        "HHHHHHHHHH",   // 8
+        "HDDDDHHHHH",   // 9
+        "DDDDDDDDHH",   // 10
+        "DDDDDDDDDH",   // 11
+        "HHSSSHHHHH",   // 12
+        "SSSSSHHHHH",   // 13
+        "SSSSSHHHHH",   // 14
+        "SSSSSHHHRH",   // 15
+        "SSSSSHHRRR",   // 16
+        "SSSSSSSSSS",   // 17
+        "SSSSSSSSSS",   // 18
+        "SSSSSSSSSS",   // 19
+        "SSSSSSSSSS",   // 20
+        "SSSSSSSSSS",   // 21
+    },
+    {   // soft
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "HHHHHHHHHH",   // 1
+        "HHHHHHHHHH",   // 2
+        "HHHHHHHHHH",   // 3
+        "HHHHHHHHHH",   // 4
+        "HHHHHHHHHH",   // 5
+        "HHHHHHHHHH",   // 6
+        "HHHHHHHHHH",   // 7
+        "HHHHHHHHHH",   // 8
+        "HHHHHHHHHH",   // 9
+        "HHHHHHHHHH",   // 10
+        "HHHHHHHHHH",   // 11
+        "HHHHDHHHHH",   // 12
+        "HHHDDHHHHH",   // 13
+        "HHHDDHHHHH",   // 14
+        "HHDDDHHHHH",   // 15
+        "HHDDDHHHHH",   // 16
+        "HDDDDHHHHH",   // 17
+        "SddddSSHHH",   // 18
+        "SSSSSSSSSS",   // 19
+        "SSSSSSSSSS",   // 20
+        "SSSSSSSSSS",   // 21
+    },
+    {   // pair
+        // 23456789TA
+        "HHHHHHHHHH",   // 0
+        "PPPPPPPPPP",   // 1
+        "PPPPPPHHHH",   // 2
+        "PPPPPPHHHH",   // 3
+        "HHHPPHHHHH",   // 4
+        "DDDDDDDDHH",   // 5
+        "PPPPPHHHHH",   // 6
+        "PPPPPPHHHH",   // 7
+        "PPPPPPPPPP",   // 8
+        "PPPPPSPPSS",   // 9
+        "SSSSSSSSSS",   // 10
+    },
+};
+
+//---------------------------------------------------------------------------
+#endif
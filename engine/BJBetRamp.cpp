@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------
+#include "BJBetRamp.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+//---------------------------------------------------------------------------
+
+std::string BJBetRamp::toString() const
+{
+    std::string out;
+    for (int s = 0; s < BJBetRampSteps; ++s) {
+        if (s) out += '-';
+        out += std::to_string(units[s]);
+    }
+    return out;
+}
+
+BJBetRamp BJBetRamp::parse(const std::string& text)
+{
+    BJBetRamp ramp;
+    int count = 0;
+
+    std::size_t pos = 0;
+    while (pos <= text.size() && count < BJBetRampSteps) {
+        std::size_t end = text.find_first_of("-,", pos);
+        if (end == std::string::npos)
+            end = text.size();
+
+        const std::string field = text.substr(pos, end - pos);
+        char* tail = nullptr;
+        const long v = std::strtol(field.c_str(), &tail, 10);
+        if (field.empty() || *tail != '\0' || v < 1 || v > 1000)
+            throw std::invalid_argument("Bad bet ramp: " + text);
+
+        ramp.units[count++] = (std::uint16_t)v;
+        pos = end + 1;
+        if (end == text.size())
+            break;
+    }
+    if (count == 0 || pos < text.size())
+        throw std::invalid_argument("Bad bet ramp: " + text);
+
+    for (int s = count; s < BJBetRampSteps; ++s)
+        ramp.units[s] = ramp.units[count - 1];
+    return ramp;
+}
+
+BJRampResult BJEvaluateRamp(const BJRampStats& stats, const BJBetRamp& ramp, double bankrollUnits)
+{
+    BJRampResult r;
+    r.ramp = ramp;
+
+    const double n = (double)stats.totalSeats();
+    double bet = 0.0, mean = 0.0, second = 0.0;
+    if (n > 0.0) {
+        for (int s = 0; s < BJBetRampSteps; ++s) {
+            const double u = (double)ramp.units[s];
+            bet    += (double)stats.seats[s] * u;
+            mean   += stats.sumNet[s] * u;
+            second += stats.sumNetSq[s] * u * u;
+        }
+        bet /= n;
+        mean /= n;
+        second /= n;
+    }
+
+    const double variance = std::max(second - mean * mean, 0.0);
+
+    r.averageBet = bet;
+    r.winRate    = mean;
+    r.stdDev     = std::sqrt(variance);
+    r.riskOfRuin = (mean > 0.0 && variance > 0.0)
+                 ? std::exp(-2.0 * mean * bankrollUnits / variance)
+                 : 1.0;
+    return r;
+}
+
+static void ExtendCandidates(const std::vector<int>& ladder, int maxSpread, int step, std::size_t from,
+                             BJBetRamp& ramp, std::vector<BJBetRamp>& out)
+{
+    if (step == BJBetRampSteps) {
+        out.push_back(ramp);
+        return;
+    }
+    for (std::size_t i = from; i < ladder.size(); ++i) {
+        if (ladder[i] > maxSpread)
+            break;
+        ramp.units[step] = (std::uint16_t)ladder[i];
+        ExtendCandidates(ladder, maxSpread, step + 1, i, ramp, out);
+    }
+}
+
+std::vector<BJBetRamp> BJRampCandidates(const std::vector<int>& ladder, int maxSpread)
+{
+    std::vector<int> values(ladder);
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    values.erase(std::remove_if(values.begin(), values.end(), [](int v) { return v < 1; }),
+                 values.end());
+
+    std::vector<BJBetRamp> out;
+    if (values.empty() || values[0] != 1)
+        values.insert(values.begin(), 1);
+
+    BJBetRamp ramp;
+    ramp.units[0] = 1;
+    ExtendCandidates(values, maxSpread, 1, 0, ramp, out);
+    return out;
+}
+
+std::vector<BJRampResult> BJOptimizeRamps(const BJRampStats& stats,
+                                          const std::vector<BJBetRamp>& candidates,
+                                          double bankrollUnits, double maxRisk, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    // contiguous slices, one per worker, each writing its own results
+    std::vector<BJRampResult> priced(candidates.size());
+    const std::size_t slice = (candidates.size() + threads - 1) / threads;
+
+    auto work = [&](std::size_t first) {
+        const std::size_t last = std::min(first + slice, candidates.size());
+        for (std::size_t i = first; i < last; ++i)
+            priced[i] = BJEvaluateRamp(stats, candidates[i], bankrollUnits);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads && t * slice < candidates.size(); ++t)
+        pool.emplace_back(work, t * slice);
+    work(0);
+    for (auto& t : pool)
+        t.join();
+
+    std::vector<BJRampResult> out;
+    for (const auto& r : priced)
+        if (r.riskOfRuin <= maxRisk)
+            out.push_back(r);
+
+    std::stable_sort(out.begin(), out.end(), [](const BJRampResult& a, const BJRampResult& b) {
+        return a.winRate > b.winRate;
+    });
+    return out;
+}
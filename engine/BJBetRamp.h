@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------
+#ifndef BJBetRampH
+#define BJBetRampH
+//---------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BJCount.h"
+#include "BJSimulator.h"
+
+// ---------------- BET RAMP ----------------
+
+// Bet units by true count, floored: step 0 covers every count below 1,
+// the last step every count at or above BJBetRampSteps - 1.
+constexpr int BJBetRampSteps = 8;
+
+struct BJBetRamp {
+    std::uint16_t units[BJBetRampSteps];
+
+    static int step(double trueCount) {
+        const double s = std::floor(trueCount);
+        if (s < 0.0)                   return 0;
+        if (s >= BJBetRampSteps - 1.0) return BJBetRampSteps - 1;
+        return (int)s;
+    }
+
+    int unitsFor(double trueCount) const { return units[step(trueCount)]; }
+
+    // Largest over smallest bet.
+    int spread() const {
+        int lo = units[0], hi = units[0];
+        for (int s = 1; s < BJBetRampSteps; ++s) {
+            if (units[s] < lo) lo = units[s];
+            if (units[s] > hi) hi = units[s];
+        }
+        return lo > 0 ? hi / lo : 0;
+    }
+
+    // "1-1-2-4-8-8-8-8"
+    std::string toString() const;
+
+    // Parses the toString() form; missing trailing steps repeat the last
+    // one. Throws std::invalid_argument on anything else.
+    static BJBetRamp parse(const std::string& text);
+};
+
+// Bets a ramp off one counting system. Bets placed right after a shuffle
+// see the fresh shoe's count.
+struct BJRampBet {
+    BJBetRamp     ramp;
+    BJCountSystem system;
+
+    template <class Game>
+    int units(const Game& g) const { return ramp.unitsFor(g.GetShoe().trueCount(system)); }
+};
+
+// ---------------- COUNT-BUCKETED RESULTS ----------------
+
+// Flat-bet results split by the true-count step at bet time, in base-bet
+// units. With the playing strategy fixed, a seat's net result scales with
+// its bet, so one run of these moments prices every ramp exactly.
+struct BJRampStats {
+    std::uint64_t rounds = 0;
+    std::uint64_t seats[BJBetRampSteps] = {};
+    double        sumNet[BJBetRampSteps] = {};
+    double        sumNetSq[BJBetRampSteps] = {};
+    double        seconds = 0.0;
+
+    void addSeat(int step, double net) {
+        ++seats[step];
+        sumNet[step]   += net;
+        sumNetSq[step] += net * net;
+    }
+
+    void merge(const BJRampStats& o) {
+        rounds += o.rounds;
+        for (int s = 0; s < BJBetRampSteps; ++s) {
+            seats[s]    += o.seats[s];
+            sumNet[s]   += o.sumNet[s];
+            sumNetSq[s] += o.sumNetSq[s];
+        }
+    }
+
+    std::uint64_t totalSeats() const {
+        std::uint64_t n = 0;
+        for (int s = 0; s < BJBetRampSteps; ++s) n += seats[s];
+        return n;
+    }
+};
+
+// Flat-bets one table and files every seat's result under the count step
+// it was bet at.
+template <class Rules, class Strategy, class Engine>
+void BJSimulateCountTable(const BJSimConfig& cfg, const Engine& engine, std::uint64_t rounds,
+                          Strategy strategy, BJCountSystem system, BJRampStats& stats)
+{
+    const int bankroll = cfg.baseBet * 1000;
+
+    BJBasicGame<Rules, Engine> game(cfg.players, bankroll, cfg.deckCount, cfg.penetration);
+    game.GetShoe().setEngine(engine);
+
+    const double unit = 1.0 / (double)cfg.baseBet;
+
+    for (std::uint64_t r = 0; r < rounds; ++r) {
+        if (game.GetShoe().needsReshuffle())
+            game.GetShoe().reshuffle();
+
+        const int step = BJBetRamp::step(game.GetShoe().trueCount(system));
+        for (int i = 0; i < cfg.players; ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(bankroll - cfg.baseBet - p.getChips());
+            p.setBet(cfg.baseBet);
+            p.setSplitBet(0);
+        }
+
+        BJPlayRound(game, strategy);
+
+        for (int i = 0; i < cfg.players; ++i)
+            stats.addSeat(step, (double)(game.GetPlayer(i).getChips() - bankroll) * unit);
+        ++stats.rounds;
+    }
+}
+
+// One flat-bet pass over cfg, split by count step; the card stream every
+// candidate ramp is priced on.
+template <class Rules, class Strategy>
+BJRampStats BJSimulateCounts(const BJSimConfig& cfg, const Strategy& strategy, BJCountSystem system)
+{
+    typedef BJXoshiro256ss Engine;
+    return BJRunTables<Engine, BJRampStats>(cfg,
+        [&cfg, &strategy, system](int, const Engine& engine, std::uint64_t rounds, BJRampStats& stats) {
+            BJSimulateCountTable<Rules>(cfg, engine, rounds, strategy, system, stats);
+        });
+}
+
+// ---------------- RAMP EVALUATION ----------------
+
+struct BJRampResult {
+    BJBetRamp ramp;
+    double    averageBet;   // units per seat-round
+    double    winRate;      // units won per seat-round
+    double    stdDev;       // per seat-round, units
+    double    riskOfRuin;   // for the bankroll it was evaluated against
+};
+
+// Prices a ramp on the bucketed results. Risk of ruin is the diffusion
+// approximation exp(-2 * winRate * bankroll / variance) for an unlimited
+// session; 1 when the ramp does not win.
+BJRampResult BJEvaluateRamp(const BJRampStats& stats, const BJBetRamp& ramp, double bankrollUnits);
+
+// Candidate ramps: non-decreasing, starting at one unit, every step drawn
+// from ladder and none above maxSpread.
+std::vector<BJBetRamp> BJRampCandidates(const std::vector<int>& ladder, int maxSpread);
+
+// Prices every candidate across threads (0 = hardware threads) and returns
+// those within maxRisk, best win rate first.
+std::vector<BJRampResult> BJOptimizeRamps(const BJRampStats& stats,
+                                          const std::vector<BJBetRamp>& candidates,
+                                          double bankrollUnits, double maxRisk,
+                                          unsigned threads = 0);
+
+//---------------------------------------------------------------------------
+#endif
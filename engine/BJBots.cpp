@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------
+#include "BJBots.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "BJDecisionManager.h"
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+//---------------------------------------------------------------------------
+
+// ---------------- BUILT-IN BOTS ----------------
+
+int BJBasicBot::placeBet(const BJGame&, const BJPlayer&)
+{
+    return bet;
+}
+
+BJAction BJBasicBot::decide(const BJGame& g, const BJPlayer& p, const BJHand& h)
+{
+    return BJBasicStrategy(table).decide(g, p, h);
+}
+
+int BJCountingBot::placeBet(const BJGame& g, const BJPlayer&)
+{
+    return unit * ramp.units(g);
+}
+
+BJAction BJCountingBot::decide(const BJGame& g, const BJPlayer& p, const BJHand& h)
+{
+    return BJBasicStrategy(table).decide(g, p, h);
+}
+
+int BJRandomBot::placeBet(const BJGame&, const BJPlayer&)
+{
+    return unit * (1 + (int)BJRandomBelow(rng, 4));
+}
+
+BJAction BJRandomBot::decide(const BJGame& g, const BJPlayer& p, const BJHand&)
+{
+    BJAction legal[BJActionCount];
+    int n = 0;
+
+    legal[n++] = BJAction::Stand;
+    legal[n++] = BJAction::Hit;
+    if (BJDecisionManager::canDoubleDown(p, g)) legal[n++] = BJAction::Double;
+    if (BJDecisionManager::canSplit(p, g))      legal[n++] = BJAction::Split;
+    if (BJDecisionManager::canSurrender(p, g))  legal[n++] = BJAction::Surrender;
+
+    return legal[BJRandomBelow(rng, (std::uint32_t)n)];
+}
+
+int BJFlatBetBot::placeBet(const BJGame&, const BJPlayer&)
+{
+    return bet;
+}
+
+BJAction BJFlatBetBot::decide(const BJGame& g, const BJPlayer& p, const BJHand& h)
+{
+    return BJMimicDealerStrategy().decide(g, p, h);
+}
+
+BJBetRamp BJDefaultCountingRamp()
+{
+    return BJBetRamp::parse("1-1-2-4-6-8");
+}
+
+std::unique_ptr<BJSeatController> BJMakeBot(BJBotKind kind, const BJRuntimeRules& rules,
+                                            int decks, int unit_bet, std::uint64_t seed)
+{
+    switch (kind) {
+        case BJBotKind::Basic:
+            return std::unique_ptr<BJSeatController>(
+                new BJBasicBot(BJBasicStrategyFor(rules, decks), unit_bet));
+        case BJBotKind::Counting:
+            return std::unique_ptr<BJSeatController>(
+                new BJCountingBot(BJBasicStrategyFor(rules, decks), BJDefaultCountingRamp(),
+                                  BJCountSystem::HiLo, unit_bet));
+        case BJBotKind::Random:
+            return std::unique_ptr<BJSeatController>(new BJRandomBot(seed, unit_bet));
+        case BJBotKind::FlatBet:
+            return std::unique_ptr<BJSeatController>(new BJFlatBetBot(unit_bet));
+        default:
+            return nullptr;
+    }
+}
+
+// ---------------- UNATTENDED SESSIONS ----------------
+
+int BJPlaceBotBets(BJGame& g, const std::vector<BJSeatController*>& seats)
+{
+    int seated = 0;
+
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        BJPlayer& p = g.GetPlayer(i);
+        p.setBet(0);
+        p.setSplitBet(0);
+
+        BJSeatController* bot = i < (int)seats.size() ? seats[i] : nullptr;
+        if (!bot || p.isBankrupt())
+            continue;
+
+        const int bet = std::min(std::max(bot->placeBet(g, p), 0), p.getChips());
+        if (bet <= 0)
+            continue;
+
+        p.adjustChips(-bet);
+        p.setBet(bet);
+        ++seated;
+    }
+    return seated;
+}
+
+void BJMarkBankrupt(BJGame& g)
+{
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        BJPlayer& p = g.GetPlayer(i);
+        if (p.getChips() <= 0)
+            p.setBankrupt(true);
+    }
+}
+
+BJBotSession BJRunBotSession(BJGame& g, const std::vector<BJSeatController*>& seats,
+                             int goal, std::uint64_t maxRounds, BJRoundLog* log)
+{
+    BJBotSession s;
+    BJSeatDispatch dispatch{ seats };
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (s.rounds < maxRounds) {
+        if (g.GetShoe().needsReshuffle())
+            g.GetShoe().reshuffle();
+
+        if (BJPlaceBotBets(g, seats) == 0)
+            break;
+
+        if (log)
+            BJPlayRecordedRound(g, dispatch, *log);
+        else
+            BJPlayRound(g, dispatch);
+        ++s.rounds;
+
+        for (int i = 0; i < g.getPlayerCount(); ++i) {
+            g.GetPlayer(i).setBet(0);
+            g.GetPlayer(i).setSplitBet(0);
+        }
+        BJMarkBankrupt(g);
+
+        s.allBankrupt = true;
+        for (int i = 0; i < g.getPlayerCount(); ++i) {
+            const BJPlayer& p = g.GetPlayer(i);
+            if (!p.isBankrupt()) {
+                s.allBankrupt = false;
+                if (p.getChips() >= goal)
+                    s.goalReached = true;
+            }
+        }
+        if (s.goalReached || s.allBankrupt)
+            break;
+    }
+
+    s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return s;
+}
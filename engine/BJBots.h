@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------
+#ifndef BJBotsH
+#define BJBotsH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BJBetRamp.h"
+#include "BJGame.h"
+#include "BJRandom.h"
+#include "BJReplay.h"
+#include "BJRound.h"
+#include "BJStrategyTable.h"
+
+// ---------------- SEAT CONTROLLERS ----------------
+
+// Whatever sits in a seat of the app's game: asked for a bet before each
+// round and for an action on each of its hands. Humans have no controller;
+// the UI drives their seats from the buttons.
+class BJSeatController {
+public:
+    virtual ~BJSeatController() {}
+
+    virtual const char* name() const = 0;
+
+    // Chips to put up this round. Anything above the player's chips is
+    // clamped to them; 0 sits the round out.
+    virtual int placeBet(const BJGame& g, const BJPlayer& p) = 0;
+
+    // Same contract as a BJPlayRound strategy: an action the rules do not
+    // allow at that point is played as a hit.
+    virtual BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) = 0;
+};
+
+// ---------------- BUILT-IN BOTS ----------------
+
+enum class BJBotKind : std::uint8_t {
+    Human = 0,
+    Basic,      // basic strategy, flat bet
+    Counting,   // basic strategy, Hi-Lo bet ramp
+    Random,     // random legal actions and bets
+    FlatBet,    // plays like the dealer, flat bet
+    Count
+};
+
+constexpr int BJBotKindCount = (int)BJBotKind::Count;
+
+inline const char* BJBotKindName(BJBotKind k)
+{
+    static const char* names[BJBotKindCount] = {
+        "human", "basic", "counting", "random", "flat"
+    };
+    return names[(int)k];
+}
+
+inline bool BJParseBotKind(const std::string& name, BJBotKind& out)
+{
+    for (int k = 0; k < BJBotKindCount; ++k) {
+        if (name == BJBotKindName((BJBotKind)k)) {
+            out = (BJBotKind)k;
+            return true;
+        }
+    }
+    return false;
+}
+
+class BJBasicBot : public BJSeatController {
+private:
+    BJStrategyTable table;
+    int             bet;
+
+public:
+    BJBasicBot(const BJStrategyTable& t, int flat_bet) : table(t), bet(flat_bet) {}
+
+    const char* name() const override { return "Basic bot"; }
+    int placeBet(const BJGame& g, const BJPlayer& p) override;
+    BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) override;
+};
+
+// Basic strategy play; bets unit chips times the ramp at the true count
+// seen at bet time.
+class BJCountingBot : public BJSeatController {
+private:
+    BJStrategyTable table;
+    BJRampBet       ramp;
+    int             unit;
+
+public:
+    BJCountingBot(const BJStrategyTable& t, const BJBetRamp& r, BJCountSystem system, int unit_bet)
+        : table(t), ramp{ r, system }, unit(unit_bet) {}
+
+    const char* name() const override { return "Counting bot"; }
+    int placeBet(const BJGame& g, const BJPlayer& p) override;
+    BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) override;
+};
+
+// Picks uniformly among the legal actions and bets 1-4 units; owns its
+// engine, so a seed replays the same choices.
+class BJRandomBot : public BJSeatController {
+private:
+    BJXoshiro256ss rng;
+    int            unit;
+
+public:
+    BJRandomBot(std::uint64_t seed, int unit_bet) : rng(seed), unit(unit_bet) {}
+
+    const char* name() const override { return "Random bot"; }
+    int placeBet(const BJGame& g, const BJPlayer& p) override;
+    BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) override;
+};
+
+// The table regular who never deviates: same bet every hand, hits below 17.
+class BJFlatBetBot : public BJSeatController {
+private:
+    int bet;
+
+public:
+    explicit BJFlatBetBot(int flat_bet) : bet(flat_bet) {}
+
+    const char* name() const override { return "Flat-bet bot"; }
+    int placeBet(const BJGame& g, const BJPlayer& p) override;
+    BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) override;
+};
+
+// Ramp the counting bot uses unless given another.
+BJBetRamp BJDefaultCountingRamp();
+
+// Builds a bot for the game's rules and deck count, betting unit_bet chips
+// per unit. Human yields nullptr. seed only matters to the random bot.
+std::unique_ptr<BJSeatController> BJMakeBot(BJBotKind kind, const BJRuntimeRules& rules,
+                                            int decks, int unit_bet, std::uint64_t seed);
+
+// ---------------- UNATTENDED SESSIONS ----------------
+
+// Routes each decision to the controller of the seat being played, so a
+// table of bots plays through BJPlayRound.
+struct BJSeatDispatch {
+    const std::vector<BJSeatController*>& seats;
+
+    BJAction decide(const BJGame& g, const BJPlayer& p, const BJHand& h) {
+        return seats[g.getCurrentPlayerIndex()]->decide(g, p, h);
+    }
+};
+
+// Collects each live seat's bet from its controller, moving the chips from
+// the stack to the bet as the chip buttons do. Seats without a controller
+// (or bankrupt) bet nothing. Returns the number of seats in the round.
+int BJPlaceBotBets(BJGame& g, const std::vector<BJSeatController*>& seats);
+
+// Marks every seat out of chips as bankrupt, as the table does between
+// rounds.
+void BJMarkBankrupt(BJGame& g);
+
+struct BJBotSession {
+    std::uint64_t rounds      = 0;
+    bool          goalReached = false;  // some seat has at least the goal
+    bool          allBankrupt = false;
+    double        seconds     = 0.0;
+};
+
+// Plays rounds with every seat bot-driven, without any UI, until a seat
+// reaches goal chips, every seat is broke, or maxRounds have been played.
+// Bets are placed after any reshuffle, so counters see the fresh shoe.
+// Every round is recorded into log when one is given.
+BJBotSession BJRunBotSession(BJGame& g, const std::vector<BJSeatController*>& seats,
+                             int goal, std::uint64_t maxRounds, BJRoundLog* log = nullptr);
+
+//---------------------------------------------------------------------------
+#endif
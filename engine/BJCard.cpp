@@ -0,0 +1,8 @@
+//---------------------------------------------------------------------------
+#include "BJCard.h"
+//---------------------------------------------------------------------------
+
+std::string BJCard::toString() const
+{
+    return std::string(getGlyph()) + " of " + BJSuitName[(int)getSuit() & 3];
+}
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------
+#ifndef BJCardH
+#define BJCardH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+
+// ---------------- ENUMS (renamed to avoid collisions) ----------------
+
+enum class BJSuit : std::uint8_t {
+    SuitSpade   = 0,
+    SuitHeart   = 1,
+    SuitClub    = 2,
+    SuitDiamond = 3
+};
+
+// Rank values 2–14 (10, J, Q, K, A)
+enum class BJRank : std::uint8_t {
+    R2 = 2, R3, R4, R5, R6, R7, R8, R9, R10,
+    RJ = 11, RQ = 12, RK = 13, RA = 14
+};
+
+enum class BJHandStatus { Active, Stood, Busted, Surrendered };
+
+// ---------------- RANK TABLES ----------------
+
+// Indexed by rank (0-15, only 2-14 are used). Points count an ace as 1;
+// hands add the extra 10 for a soft total themselves. Points double as the
+// rank class (1 = ace, 2-9, 10 = ten-valued) used for shoe compositions.
+inline constexpr std::uint8_t BJRankPoints[16] = {
+    0, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 1, 0
+};
+
+inline constexpr bool BJRankIsTen[16] = {
+    false, false, false, false, false, false, false, false, false, false,
+    true,  true,  true,  true,  false, false
+};
+
+inline constexpr bool BJRankIsAce[16] = {
+    false, false, false, false, false, false, false, false, false, false,
+    false, false, false, false, true,  false
+};
+
+inline constexpr const char* BJRankGlyph[16] = {
+    "", "", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K", "A", ""
+};
+
+inline constexpr const char* BJSuitName[4] = {
+    "Spades", "Hearts", "Clubs", "Diamonds"
+};
+
+// ---------------- CARD ----------------
+
+// One byte: suit in the high nibble, rank in the low nibble. A
+// default-constructed card has code 0 and is worth 0 points.
+class BJCard {
+private:
+    std::uint8_t code;
+
+public:
+    BJCard() : code(0) {}
+    BJCard(BJSuit s, BJRank r)
+        : code((std::uint8_t)(((std::uint8_t)s << 4) | (std::uint8_t)r)) {}
+
+    static BJCard fromCode(std::uint8_t c) { BJCard card; card.code = c; return card; }
+    std::uint8_t getCode() const { return code; }
+
+    BJSuit getSuit() const { return (BJSuit)(code >> 4); }
+    BJRank getRank() const { return (BJRank)(code & 0x0F); }
+
+    int  getPoints() const { return BJRankPoints[code & 0x0F]; }
+    bool isTen()     const { return BJRankIsTen[code & 0x0F]; }
+    bool isAce()     const { return BJRankIsAce[code & 0x0F]; }
+
+    const char* getGlyph() const { return BJRankGlyph[code & 0x0F]; }
+
+    bool operator==(const BJCard& o) const { return code == o.code; }
+    bool operator!=(const BJCard& o) const { return code != o.code; }
+
+    std::string toString() const;
+};
+
+static_assert(sizeof(BJCard) == 1, "BJCard must stay one byte");
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------------
+#ifndef BJCardArrayH
+#define BJCardArrayH
+//---------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+#include "BJCard.h"
+
+// A hand stops drawing once it reaches 21, so every card but the last was
+// added on a hard total of 20 or less. With each card worth at least 1 that
+// caps any hand, for any number of decks, at 20 + 1 cards.
+constexpr int BJMaxHandCards = 21;
+
+// ---------------- OVERFLOW POLICIES ----------------
+
+struct BJThrowOnOverflow {
+    static void onOverflow() { throw std::length_error("Hand is full."); }
+};
+
+// For simulator builds that have proven the capacity bound: no check in
+// release builds.
+struct BJAssertOnOverflow {
+    static void onOverflow() { assert(!"Hand is full."); }
+};
+
+// ---------------- CARD ARRAY ----------------
+
+// Fixed-capacity inline card storage with the read-only surface of a
+// std::vector (size/empty/operator[]/iteration), so a hand never touches
+// the heap.
+template <int Capacity, class OverflowPolicy = BJThrowOnOverflow>
+class BJCardArray {
+private:
+    BJCard cards[Capacity];
+    int    count;
+
+public:
+    typedef const BJCard* const_iterator;
+
+    BJCardArray() : count(0) {}
+
+    static constexpr int capacity() { return Capacity; }
+
+    void push_back(const BJCard& c) {
+        if (count >= Capacity) {
+            OverflowPolicy::onOverflow();
+            return;
+        }
+        cards[count++] = c;
+    }
+
+    void clear() noexcept { count = 0; }
+
+    std::size_t size()  const noexcept { return (std::size_t)count; }
+    bool        empty() const noexcept { return count == 0; }
+
+    const BJCard& operator[](std::size_t i) const { return cards[i]; }
+    const BJCard& front() const { return cards[0]; }
+    const BJCard& back()  const { return cards[count - 1]; }
+
+    const BJCard* data() const noexcept { return cards; }
+
+    const_iterator begin() const noexcept { return cards; }
+    const_iterator end()   const noexcept { return cards + count; }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------
+#ifndef BJCompositionH
+#define BJCompositionH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "BJCard.h"
+
+// ---------------- SHOE COMPOSITION ----------------
+
+// Card counts by rank class (BJRankPoints: 1 = ace, 2-9, 10 = ten-valued),
+// which is all the probability code needs to know about a shoe.
+class BJShoeComposition {
+public:
+    static constexpr int Classes = 11;    // index 0 unused
+
+private:
+    std::uint16_t counts[Classes];
+    int           total;
+
+public:
+    BJShoeComposition() : counts(), total(0) {}
+
+    static BJShoeComposition full(int deckCount) {
+        BJShoeComposition c;
+        for (int cls = 1; cls <= 9; ++cls)
+            c.counts[cls] = (std::uint16_t)(4 * deckCount);
+        c.counts[10] = (std::uint16_t)(16 * deckCount);
+        c.total = 52 * deckCount;
+        return c;
+    }
+
+    static BJShoeComposition fromCards(const BJCard* first, const BJCard* last) {
+        BJShoeComposition c;
+        for (; first != last; ++first)
+            c.add(first->getPoints());
+        return c;
+    }
+
+    int count(int cls) const { return counts[cls]; }
+    int size()         const { return total; }
+
+    void add(int cls)    { ++counts[cls]; ++total; }
+    void remove(int cls) { --counts[cls]; --total; }
+    void remove(int cls, int n) { counts[cls] = (std::uint16_t)(counts[cls] - n); total -= n; }
+
+    void add(const BJCard& c)    { add(c.getPoints()); }
+    void remove(const BJCard& c) { remove(c.getPoints()); }
+
+    // Packs the counts into 62 bits: six bits for each of A-9 and eight for
+    // tens, enough for an 8-deck shoe.
+    std::uint64_t key() const {
+        std::uint64_t k = counts[10];
+        for (int cls = 1; cls <= 9; ++cls)
+            k = (k << 6) | counts[cls];
+        return k;
+    }
+
+    bool operator==(const BJShoeComposition& o) const {
+        for (int cls = 1; cls < Classes; ++cls)
+            if (counts[cls] != o.counts[cls])
+                return false;
+        return true;
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
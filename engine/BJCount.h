@@ -0,0 +1,142 @@
+//---------------------------------------------------------------------------
+#ifndef BJCountH
+#define BJCountH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+
+#include "BJCard.h"
+#include "BJComposition.h"
+
+// ---------------- COUNTING SYSTEMS ----------------
+
+enum class BJCountSystem : std::uint8_t {
+    HiLo,
+    KO,
+    HiOptI,
+    HiOptII,
+    OmegaII,
+    Zen,
+    Count
+};
+
+constexpr int BJCountSystemCount = (int)BJCountSystem::Count;
+
+// Tag per rank class (index 1 = ace .. 10 = tens; 0 unused).
+inline constexpr std::int8_t BJCountTags[BJCountSystemCount][11] = {
+    //  -   A   2   3   4   5   6   7   8   9   T
+    {   0, -1,  1,  1,  1,  1,  1,  0,  0,  0, -1 },   // Hi-Lo
+    {   0, -1,  1,  1,  1,  1,  1,  1,  0,  0, -1 },   // KO
+    {   0,  0,  0,  1,  1,  1,  1,  0,  0,  0, -1 },   // Hi-Opt I
+    {   0,  0,  1,  1,  2,  2,  1,  1,  0,  0, -2 },   // Hi-Opt II
+    {   0,  0,  1,  1,  2,  2,  2,  1,  0, -1, -2 },   // Omega II
+    {   0, -1,  1,  1,  2,  2,  2,  1,  0,  0, -2 },   // Zen
+};
+
+// Unbalanced systems start the running count below zero, per deck in the
+// shoe, so that it reaches the pivot at the same point for any deck count.
+// KO starts at 4 - 4 x decks.
+inline constexpr int BJCountStartPerDeck[BJCountSystemCount] = { 0, -4, 0, 0, 0, 0 };
+inline constexpr int BJCountStartOffset[BJCountSystemCount]  = { 0,  4, 0, 0, 0, 0 };
+
+inline constexpr const char* BJCountSystemNames[BJCountSystemCount] = {
+    "Hi-Lo", "KO", "Hi-Opt I", "Hi-Opt II", "Omega II", "Zen"
+};
+
+inline const char* BJCountSystemName(BJCountSystem s) { return BJCountSystemNames[(int)s]; }
+
+// Matches a name ignoring case and punctuation: "hilo", "Hi-Opt II",
+// "omegaii". Returns false for anything else.
+inline bool BJParseCountSystem(const char* name, BJCountSystem& out)
+{
+    auto squash = [](const char* p, char* buf, int cap) {
+        int n = 0;
+        for (; *p && n < cap - 1; ++p) {
+            char c = *p;
+            if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) buf[n++] = c;
+        }
+        buf[n] = '\0';
+    };
+
+    char want[32], have[32];
+    squash(name, want, sizeof(want));
+    for (int s = 0; s < BJCountSystemCount; ++s) {
+        squash(BJCountSystemNames[s], have, sizeof(have));
+        if (std::strcmp(want, have) == 0) {
+            out = (BJCountSystem)s;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------- CARD COUNTER ----------------
+
+// Cards dealt since the last shuffle, per rank and per rank class, with the
+// running count of every system updated as each card is added. Every query
+// is O(1).
+class BJCardCounter {
+private:
+    std::uint16_t byRank[16];
+    std::uint16_t byClass[11];
+    int           dealt;
+    int           running[BJCountSystemCount];
+    int           deckCount;
+
+public:
+    explicit BJCardCounter(int deck_count = 1) { reset(deck_count); }
+
+    void reset(int deck_count) {
+        deckCount = deck_count;
+        reset();
+    }
+
+    void reset() {
+        for (auto& n : byRank)  n = 0;
+        for (auto& n : byClass) n = 0;
+        dealt = 0;
+        for (int s = 0; s < BJCountSystemCount; ++s)
+            running[s] = BJCountStartOffset[s] + BJCountStartPerDeck[s] * deckCount;
+    }
+
+    void add(const BJCard& c) {
+        const int cls = c.getPoints();
+        ++byRank[(int)c.getRank()];
+        ++byClass[cls];
+        ++dealt;
+        for (int s = 0; s < BJCountSystemCount; ++s)
+            running[s] += BJCountTags[s][cls];
+    }
+
+    int getDealt()            const { return dealt; }
+    int getDealt(BJRank r)    const { return byRank[(int)r]; }
+    int getDealtClass(int cls) const { return byClass[cls]; }
+    int getDeckCount()        const { return deckCount; }
+
+    int runningCount(BJCountSystem s = BJCountSystem::HiLo) const { return running[(int)s]; }
+
+    // Cards still to come, in decks.
+    double decksRemaining() const {
+        return (double)(deckCount * 52 - dealt) / 52.0;
+    }
+
+    // Running count per deck remaining. Unbalanced systems (KO) are normally
+    // bet off the running count; this divides it all the same.
+    double trueCount(BJCountSystem s = BJCountSystem::HiLo) const {
+        const double decks = decksRemaining();
+        return decks > 0.0 ? (double)running[(int)s] / decks : 0.0;
+    }
+
+    // The undealt cards: the full shoe less what has been counted.
+    BJShoeComposition remainingComposition() const {
+        BJShoeComposition c = BJShoeComposition::full(deckCount);
+        for (int cls = 1; cls <= 10; ++cls)
+            c.remove(cls, byClass[cls]);
+        return c;
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,23 @@
+//---------------------------------------------------------------------------
+#ifndef BJDealerH
+#define BJDealerH
+//---------------------------------------------------------------------------
+
+#include "BJHand.h"
+
+// ---------------- DEALER ----------------
+
+class BJDealer {
+private:
+    BJHand hand;
+public:
+    BJDealer() : hand() {}
+
+    BJHand&       GetHand()       noexcept { return hand; }
+    const BJHand& GetHand() const noexcept { return hand; }
+
+    void clearHand() { hand.clear(); }
+};
+
+//---------------------------------------------------------------------------
+#endif
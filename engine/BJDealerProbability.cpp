@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------
+#include "BJDealerProbability.h"
+
+#include <algorithm>
+#include <utility>
+//---------------------------------------------------------------------------
+
+void BJDealerProbability::play(int hard, bool hasAce, int cards, int upcard, double prob,
+                               BJShoeComposition& shoe, BJDealerOutcome& out) const
+{
+    const bool soft  = hasAce && hard + 10 <= 21;
+    const int  value = soft ? hard + 10 : hard;
+
+    if (cards == 2 && value == 21) {
+        out.p[BJDealerOutcome::Natural] += prob;
+        return;
+    }
+    if (value > 21) {
+        out.p[BJDealerOutcome::Bust] += prob;
+        return;
+    }
+    if (value >= 17 && !(hitSoft17 && value == 17 && soft)) {
+        out.p[value - 17] += prob;
+        return;
+    }
+
+    // Hole card after a failed peek: the card that would make blackjack is
+    // excluded and the rest renormalised.
+    int excluded = 0;
+    if (cards == 1 && peek) {
+        if (upcard == 1)  excluded = 10;
+        if (upcard == 10) excluded = 1;
+    }
+
+    const int total = shoe.size() - (excluded ? shoe.count(excluded) : 0);
+    if (total <= 0)
+        return;
+
+    for (int cls = 1; cls <= 10; ++cls) {
+        const int n = shoe.count(cls);
+        if (n == 0 || cls == excluded)
+            continue;
+
+        const double p = prob * (double)n / (double)total;
+        shoe.remove(cls);
+        play(hard + cls, hasAce || cls == 1, cards + 1, upcard, p, shoe, out);
+        shoe.add(cls);
+    }
+}
+
+BJDealerOutcome BJDealerProbability::compute(int upcard, const BJShoeComposition& shoe) const
+{
+    BJDealerOutcome out = {};
+    BJShoeComposition work = shoe;
+    play(upcard, upcard == 1, 1, upcard, 1.0, work, out);
+    return out;
+}
+
+const BJDealerOutcome& BJDealerProbability::store(const Key& key, const BJDealerOutcome& value)
+{
+    if (recent.size() >= std::max<std::size_t>(maxEntries / 2, 1)) {
+        older = std::move(recent);
+        recent.clear();
+    }
+    return recent.emplace(key, value).first->second;
+}
+
+// The same walk as play(), one state at a time: the distribution from
+// (hard, hasAce) on, given the dealer got there, out of the cache or built
+// from the next card's states.
+const BJDealerOutcome& BJDealerProbability::node(int hard, bool hasAce, bool upcardOnly,
+                                                 BJShoeComposition& shoe)
+{
+    const Key key = { shoe.key(),
+                      (std::uint8_t)(hard | (hasAce ? 0x20 : 0) | (upcardOnly ? 0x40 : 0)) };
+
+    auto it = recent.find(key);
+    if (it != recent.end()) {
+        ++hits;
+        return it->second;
+    }
+    it = older.find(key);
+    if (it != older.end()) {
+        ++hits;
+        const BJDealerOutcome value = it->second;
+        return store(key, value);
+    }
+    ++misses;
+
+    // Hole card after a failed peek: the card that would make blackjack is
+    // excluded and the rest renormalised.
+    int excluded = 0;
+    if (upcardOnly && peek) {
+        if (hard == 1)  excluded = 10;
+        if (hard == 10) excluded = 1;
+    }
+
+    BJDealerOutcome out = {};
+    const int total = shoe.size() - (excluded ? shoe.count(excluded) : 0);
+
+    for (int cls = 1; total > 0 && cls <= 10; ++cls) {
+        const int n = shoe.count(cls);
+        if (n == 0 || cls == excluded)
+            continue;
+
+        const double p     = (double)n / (double)total;
+        const int    h     = hard + cls;
+        const bool   ace   = hasAce || cls == 1;
+        const bool   soft  = ace && h + 10 <= 21;
+        const int    value = soft ? h + 10 : h;
+
+        if (upcardOnly && value == 21)
+            out.p[BJDealerOutcome::Natural] += p;
+        else if (value > 21)
+            out.p[BJDealerOutcome::Bust] += p;
+        else if (value >= 17 && !(hitSoft17 && value == 17 && soft))
+            out.p[value - 17] += p;
+        else {
+            shoe.remove(cls);
+            const BJDealerOutcome& next = node(h, ace, false, shoe);
+            for (int k = 0; k < BJDealerOutcome::Count; ++k)
+                out.p[k] += p * next.p[k];
+            shoe.add(cls);
+        }
+    }
+    return store(key, out);
+}
+
+const BJDealerOutcome& BJDealerProbability::outcome(int upcard, const BJShoeComposition& shoe)
+{
+    BJShoeComposition work = shoe;
+    return node(upcard, upcard == 1, true, work);
+}
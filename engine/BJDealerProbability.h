@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------
+#ifndef BJDealerProbabilityH
+#define BJDealerProbabilityH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "BJComposition.h"
+#include "BJRules.h"
+
+// ---------------- DEALER OUTCOME PROBABILITIES ----------------
+
+// Final dealer totals, exact for a given upcard and remaining shoe.
+struct BJDealerOutcome {
+    enum { P17 = 0, P18, P19, P20, P21, Bust, Natural, Count };
+
+    double p[Count];
+
+    // Probability of finishing on total (17-21).
+    double total(int t) const { return p[t - 17]; }
+    double bust()       const { return p[Bust]; }
+    double natural()    const { return p[Natural]; }
+};
+
+// Walks every dealer draw sequence over the shoe composition, weighting by
+// the remaining counts, for S17 or H17. With a peeking dealer and an ace or
+// ten up, the hole card is conditioned on the dealer not having blackjack
+// (the players only act after a failed peek), so natural() is 0.
+//
+// Results are memoised per dealer state: the unseen composition with the
+// dealer's hard total, ace and whether only the upcard is out. A query
+// walks the draw tree through that cache, so draw orders that meet again
+// (2 then 3, 3 then 2) are walked once, and a shoe one card down from an
+// earlier query finds most of its subtrees already there. Entries live in
+// two generations of max_entries / 2: when the newer fills it becomes the
+// older and the old one is dropped, and a hit in the older moves the entry
+// back up, so states still in use survive. Not thread-safe; give each
+// thread its own instance.
+class BJDealerProbability {
+private:
+    struct Key {
+        std::uint64_t composition;
+        std::uint8_t  state;         // hard total | ace << 5 | upcard only << 6
+        bool operator==(const Key& o) const {
+            return composition == o.composition && state == o.state;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t z = k.composition * 0x9E3779B97F4A7C15ull + k.state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return (std::size_t)(z ^ (z >> 31));
+        }
+    };
+
+    typedef std::unordered_map<Key, BJDealerOutcome, KeyHash> Cache;
+
+    bool        hitSoft17;
+    bool        peek;
+    std::size_t maxEntries;
+
+    Cache         recent;
+    Cache         older;
+    std::uint64_t hits;
+    std::uint64_t misses;
+
+    const BJDealerOutcome& store(const Key& key, const BJDealerOutcome& value);
+    const BJDealerOutcome& node(int hard, bool hasAce, bool upcardOnly, BJShoeComposition& shoe);
+
+    void play(int hard, bool hasAce, int cards, int upcard, double prob,
+              BJShoeComposition& shoe, BJDealerOutcome& out) const;
+
+public:
+    // Only the dealer's rules (H17, peek) matter here.
+    template <class Rules>
+    explicit BJDealerProbability(const Rules& rules, std::size_t max_entries = 1u << 20)
+        : hitSoft17(rules.hitSoft17()), peek(rules.dealerPeek()),
+          maxEntries(max_entries), hits(0), misses(0) {}
+
+    // upcard is a rank class (1 = ace .. 10); shoe holds the unseen cards,
+    // i.e. without the upcard. The reference is good until the next call.
+    const BJDealerOutcome& outcome(int upcard, const BJShoeComposition& shoe);
+
+    // Uncached computation, walking every draw sequence.
+    BJDealerOutcome compute(int upcard, const BJShoeComposition& shoe) const;
+
+    void          clear()           { recent.clear(); older.clear(); }
+    std::size_t   size()      const { return recent.size() + older.size(); }
+
+    // Lookups of any dealer state, the subtrees of a query included.
+    std::uint64_t cacheHits()  const { return hits; }
+    std::uint64_t cacheMisses() const { return misses; }
+};
+
+//---------------------------------------------------------------------------
+#endif
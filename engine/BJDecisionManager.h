@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------
+#ifndef BJDecisionManagerH
+#define BJDecisionManagerH
+//---------------------------------------------------------------------------
+
+#include "BJGame.h"
+#include "BJRules.h"
+
+// -------------- Decision Manager ----------------
+
+// Legal-action checks for the current hand, against the game's rules
+// policy. Works with BJGame and any BJBasicGame instantiation.
+class BJDecisionManager {
+public:
+    template <class Game>
+    static bool canAct(const BJPlayer& p, const Game& g) {
+        if (p.isBankrupt())
+            return false;
+        if (p.getID() != g.GetCurrentPlayer().getID())
+            return false;
+        return true;
+    }
+
+    template <class Game>
+    static bool canHit(const BJPlayer& p, const Game& g) {
+        if (!canAct(p, g))
+            return false;
+
+        const BJHand& h = (g.getCurrentHandIndex() == 0 ? p.GetHand() : p.GetSplitHand());
+
+        if (h.value() >= 21)
+            return false;
+
+        if (g.getCurrentHandIndex() == 0)
+            return (p.getBet() > 0);
+        else
+            return (p.getSplitBet() > 0);
+    }
+
+    template <class Game>
+    static bool canStand(const BJPlayer& p, const Game& g) {
+        if (!canAct(p, g))
+            return false;
+
+        const BJHand& h = (g.getCurrentHandIndex() == 0 ? p.GetHand() : p.GetSplitHand());
+
+        if (h.value() <= 0)
+            return false;
+
+        if (g.getCurrentHandIndex() == 0)
+            return (p.getBet() > 0);
+        else
+            return (p.getSplitBet() > 0);
+    }
+
+    template <class Game>
+    static bool canDoubleDown(const BJPlayer& p, const Game& g) {
+        if (!canAct(p, g))
+            return false;
+
+        int handIndex = g.getCurrentHandIndex();
+        const BJHand& h =
+            (handIndex == 0 ? p.GetHand() : p.GetSplitHand());
+
+        if (p.hasActedOnHand(handIndex))
+            return false;
+
+        if (h.size() != 2)
+            return false;
+
+        if (p.hasSplitHand() && !g.GetRules().doubleAfterSplit())
+            return false;
+
+        if (!BJDoubleAllowedOnTotal(g.GetRules(), h.value()))
+            return false;
+
+        int bet = (handIndex == 0 ? p.getBet() : p.getSplitBet());
+        if (bet <= 0)
+            return false;
+
+        return (p.getChips() >= bet);
+    }
+
+    template <class Game>
+    static bool canSplit(const BJPlayer& p, const Game& g) {
+        if (!canAct(p, g))
+            return false;
+
+        if (g.GetRules().maxSplitHands() < 2)
+            return false;
+
+        if (g.getCurrentHandIndex() != 0)
+            return false;
+
+        if (p.hasSplitHand())
+            return false;
+
+        const BJHand& h = p.GetHand();
+        if (h.size() != 2)
+            return false;
+
+        const auto& cards = h.GetCards();
+        if (cards[0].getPoints() != cards[1].getPoints())
+            return false;
+
+        int bet = p.getBet();
+        if (bet <= 0)
+            return false;
+        if (p.getChips() < bet)
+            return false;
+
+        return true;
+    }
+
+    // Late surrender: first decision on an unsplit two-card hand, after
+    // the dealer has checked for blackjack.
+    template <class Game>
+    static bool canSurrender(const BJPlayer& p, const Game& g) {
+        if (!canAct(p, g))
+            return false;
+
+        if (!g.GetRules().lateSurrender())
+            return false;
+
+        if (g.getCurrentHandIndex() != 0 || p.hasSplitHand())
+            return false;
+
+        if (p.hasActedOnHand(0) || p.GetHand().size() != 2)
+            return false;
+
+        return (p.getBet() > 0);
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,24 @@
+//---------------------------------------------------------------------------
+#ifndef BJEngineH
+#define BJEngineH
+//---------------------------------------------------------------------------
+
+// Headless blackjack engine. Nothing below this header may include FMX/VCL
+// or System.* units; UI-specific helpers live in BJCardAdapter.
+
+#include "BJCard.h"
+#include "BJComposition.h"
+#include "BJCount.h"
+#include "BJHand.h"
+#include "BJRandom.h"
+#include "BJShoe.h"
+#include "BJPlayer.h"
+#include "BJRules.h"
+#include "BJSettlement.h"
+#include "BJDealer.h"
+#include "BJGame.h"
+#include "BJDecisionManager.h"
+#include "BJRound.h"
+
+//---------------------------------------------------------------------------
+#endif
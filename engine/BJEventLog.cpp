@@ -0,0 +1,267 @@
+//---------------------------------------------------------------------------
+#include "BJEventLog.h"
+
+#include <chrono>
+#include <stdexcept>
+//---------------------------------------------------------------------------
+
+// ---------------- RING ----------------
+
+BJEventRing::BJEventRing(std::size_t capacity)
+    : head(0), tailSeen(0), tail(0), headSeen(0)
+{
+    std::size_t n = 2;
+    while (n < capacity)
+        n <<= 1;
+    slots.reset(new BJEvent[n]);
+    mask = n - 1;
+}
+
+std::size_t BJEventRing::pop(BJEvent* out, std::size_t max) noexcept
+{
+    const std::uint64_t t = tail.load(std::memory_order_relaxed);
+    if (headSeen == t)
+        headSeen = head.load(std::memory_order_acquire);
+
+    std::size_t n = (std::size_t)(headSeen - t);
+    if (n > max)
+        n = max;
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = slots[(t + i) & mask];
+    if (n)
+        tail.store(t + n, std::memory_order_release);
+    return n;
+}
+
+// ---------------- LOG ----------------
+
+BJEventLog::BJEventLog(Sink s, std::size_t ring_events)
+    : sink(std::move(s)), ringEvents(ring_events), channelCount(0), stopping(false), delivered(0)
+{
+    for (auto& c : channels)
+        c.store(nullptr, std::memory_order_relaxed);
+    writer = std::thread([this]() { run(); });
+}
+
+BJEventLog::~BJEventLog()
+{
+    try {
+        stop();
+    } catch (...) {
+    }
+    for (auto& c : channels)
+        delete c.load(std::memory_order_relaxed);
+}
+
+BJEventChannel& BJEventLog::openChannel(BJEventOverflow policy)
+{
+    const int slot = channelCount.fetch_add(1);
+    if (slot >= MaxChannels)
+        throw std::length_error("Too many event channels");
+
+    BJEventChannel* ch = new BJEventChannel(ringEvents, policy);
+    channels[slot].store(ch, std::memory_order_release);
+    return *ch;
+}
+
+std::size_t BJEventLog::drainAll(std::vector<BJEvent>& buf)
+{
+    std::size_t total = 0;
+    int n = channelCount.load(std::memory_order_acquire);
+    if (n > MaxChannels)
+        n = MaxChannels;
+
+    // one batch per channel per turn, so a producer that keeps its ring
+    // full cannot hold the writer while the others overflow
+    for (std::size_t turn = 1; turn; total += turn) {
+        turn = 0;
+        for (int c = 0; c < n; ++c) {
+            BJEventChannel* ch = channels[c].load(std::memory_order_acquire);
+            if (!ch)
+                continue;               // claimed, not yet published
+            const std::size_t got = ch->ring.pop(buf.data(), buf.size());
+            if (!got)
+                continue;
+            turn += got;
+            if (error)
+                continue;               // the sink failed: just make room
+            try {
+                sink(c, buf.data(), got);
+                delivered.store(delivered.load(std::memory_order_relaxed) + got,
+                                std::memory_order_relaxed);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+    }
+    return total;
+}
+
+void BJEventLog::run()
+{
+    std::vector<BJEvent> buf(4096);
+    for (;;) {
+        // read the flag first: whatever was logged before stop() is then
+        // in the rings this pass drains
+        const bool last = stopping.load(std::memory_order_acquire);
+        if (drainAll(buf))
+            continue;
+        if (last)
+            return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void BJEventLog::stop()
+{
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+std::uint64_t BJEventLog::getDropped() const noexcept
+{
+    std::uint64_t n = 0;
+    for (const auto& c : channels) {
+        if (const BJEventChannel* ch = c.load(std::memory_order_acquire))
+            n += ch->getDropped();
+    }
+    return n;
+}
+
+// ---------------- HAND-HISTORY SINK ----------------
+
+void BJHistoryEventSink::operator()(int channel, const BJEvent* events, std::size_t n)
+{
+    if ((int)channels.size() <= channel)
+        channels.resize(channel + 1);
+    Assembly& a = channels[channel];
+    for (std::size_t i = 0; i < n; ++i)
+        add(a, events[i]);
+}
+
+void BJHistoryEventSink::add(Assembly& a, const BJEvent& e)
+{
+    if (e.type == BJEventType::RoundBegin) {
+        if (a.open)
+            ++lost;                     // its RoundEnd never came
+        a.open        = true;
+        a.round       = e.round;
+        a.events      = 1;
+        a.count10     = e.value;
+        a.dealerCount = 0;
+        a.seatCount   = 0;
+        return;
+    }
+    if (a.open && e.round != a.round) {
+        ++lost;                         // this one's RoundEnd never came
+        a.open = false;
+    }
+    if (!a.open) {
+        if (e.type == BJEventType::RoundEnd)
+            ++lost;                     // its RoundBegin never came
+        return;
+    }
+    if (e.type == BJEventType::RoundEnd) {
+        finish(a, e);
+        return;
+    }
+    ++a.events;
+
+    // the seat an event names, by table seat
+    Seat* seat = nullptr;
+    if (e.seat != BJEventDealer) {
+        for (int s = 0; s < a.seatCount; ++s) {
+            if (a.seats[s].seat == e.seat)
+                seat = &a.seats[s];
+        }
+    }
+    Hand* hand = seat && e.hand < seat->handCount ? &seat->hands[e.hand] : nullptr;
+
+    switch (e.type) {
+        case BJEventType::Bet:
+            if (a.seatCount < BJHistoryMaxSeats) {
+                Seat& s     = a.seats[a.seatCount++];
+                s.seat      = e.seat;
+                s.bet       = e.value;
+                s.net       = 0;
+                s.handCount = 1;
+                s.hands[0]  = Hand();
+                s.hands[1]  = Hand();
+            }
+            break;
+
+        case BJEventType::Deal:
+        case BJEventType::Draw:
+        case BJEventType::DealerDraw:
+            if (e.seat == BJEventDealer) {
+                if (a.dealerCount < BJMaxHandCards)
+                    a.dealer[a.dealerCount++] = BJCard::fromCode(e.code);
+            } else if (hand && hand->count < BJMaxHandCards) {
+                hand->cards[hand->count++] = BJCard::fromCode(e.code);
+            }
+            break;
+
+        case BJEventType::Action:
+            // a split takes the second card over to the new hand
+            if (seat && (BJAction)e.code == BJAction::Split && seat->handCount == 1 &&
+                seat->hands[0].count == 2) {
+                seat->handCount         = 2;
+                seat->hands[1].cards[0] = seat->hands[0].cards[1];
+                seat->hands[1].count    = 1;
+                seat->hands[0].count    = 1;
+            }
+            break;
+
+        case BJEventType::Settle:
+            if (hand) {
+                hand->outcome     = (e.code & 3) - 1;
+                hand->doubled     = (e.code & 4) != 0;
+                hand->surrendered = (e.code & 8) != 0;
+                seat->net         = e.value;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void BJHistoryEventSink::finish(Assembly& a, const BJEvent& e)
+{
+    a.open = false;
+    if (e.value != a.events) {
+        ++lost;
+        return;
+    }
+
+    BJHistoryRound r;
+    r.round           = 0;
+    r.trueCount10     = a.count10;
+    r.dealerCards     = a.dealer;
+    r.dealerCardCount = a.dealerCount;
+    r.seatCount       = a.seatCount;
+    for (int s = 0; s < a.seatCount; ++s) {
+        const Seat&    in  = a.seats[s];
+        BJHistorySeat& out = r.seats[s];
+        out.seat      = in.seat;
+        out.bet       = in.bet;
+        out.net       = in.net;
+        out.handCount = in.handCount;
+        for (int h = 0; h < in.handCount; ++h) {
+            out.hands[h].cards       = in.hands[h].cards;
+            out.hands[h].cardCount   = in.hands[h].count;
+            out.hands[h].outcome     = in.hands[h].outcome;
+            out.hands[h].doubled     = in.hands[h].doubled;
+            out.hands[h].surrendered = in.hands[h].surrendered;
+        }
+    }
+    writer.writeRound(r);
+    ++written;
+}
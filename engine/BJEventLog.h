@@ -0,0 +1,412 @@
+//---------------------------------------------------------------------------
+#ifndef BJEventLogH
+#define BJEventLogH
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BJGame.h"
+#include "BJHandHistory.h"
+#include "BJRound.h"
+
+// ---------------- EVENTS ----------------
+
+// What happened at the table, one fixed-size record per thing. Cards are
+// BJCard codes; seats are 0-based, BJEventDealer for the dealer.
+enum class BJEventType : std::uint8_t {
+    RoundBegin,     // value: Hi-Lo true count at the deal, tenths
+    Bet,            // seat; value: the bet
+    Reshuffle,      // value: the shoe's shuffle count
+    Deal,           // seat or dealer, hand; code: card. The first two cards
+    Draw,           // seat, hand; code: card. Hits, doubles and split cards
+    DealerDraw,     // code: card
+    Action,         // seat, hand; code: the BJAction, once it has been made
+    Settle,         // seat, hand; code: outcome + 1 | doubled << 2 |
+                    // surrendered << 3; value: the seat's chips won or lost
+    RoundEnd        // value: events in the round before this one
+};
+
+constexpr std::uint8_t BJEventDealer = 0xFF;
+
+struct BJEvent {
+    std::uint64_t round;            // producer's round number
+    BJEventType   type;
+    std::uint8_t  seat;
+    std::uint8_t  hand;
+    std::uint8_t  code;
+    std::int32_t  value;
+};
+
+static_assert(sizeof(BJEvent) == 16, "events are packed four to a cache line");
+
+// ---------------- RING ----------------
+
+// Bounded single-producer single-consumer queue. Each side owns one index
+// and keeps a stale copy of the other, so a push or pop touches shared
+// memory only when that copy says the ring looks full or empty. Indices
+// never wrap; capacity is a power of two.
+class BJEventRing {
+private:
+    std::unique_ptr<BJEvent[]> slots;
+    std::uint64_t              mask;
+
+    alignas(64) std::atomic<std::uint64_t> head;    // next to write, producer's
+    std::uint64_t                          tailSeen;
+    alignas(64) std::atomic<std::uint64_t> tail;    // next to read, consumer's
+    std::uint64_t                          headSeen;
+
+public:
+    explicit BJEventRing(std::size_t capacity);
+
+    std::size_t capacity() const noexcept { return (std::size_t)mask + 1; }
+
+    // Producer side. False, with nothing written, when the ring is full.
+    bool push(const BJEvent& e) noexcept {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tailSeen > mask) {
+            tailSeen = tail.load(std::memory_order_acquire);
+            if (h - tailSeen > mask)
+                return false;
+        }
+        slots[h & mask] = e;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies up to max events out; returns how many.
+    std::size_t pop(BJEvent* out, std::size_t max) noexcept;
+};
+
+// ---------------- CHANNEL ----------------
+
+// What a producer does when its ring is full: drop the event (a game
+// thread, which must never wait) or yield until the writer makes room (a
+// simulator worker, which would rather slow down than lose rounds).
+enum class BJEventOverflow : std::uint8_t {
+    Drop,
+    Wait
+};
+
+// One producer's ring. Only the thread that opened it may log to it.
+class BJEventChannel {
+private:
+    BJEventRing                ring;
+    BJEventOverflow            overflow;
+    std::atomic<std::uint64_t> dropped;
+
+    friend class BJEventLog;
+
+public:
+    BJEventChannel(std::size_t capacity, BJEventOverflow policy)
+        : ring(capacity), overflow(policy), dropped(0) {}
+
+    void log(const BJEvent& e) noexcept {
+        while (!ring.push(e)) {
+            if (overflow == BJEventOverflow::Drop) {
+                // one writer, so no read-modify-write needed
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    std::uint64_t getDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+};
+
+// ---------------- LOG ----------------
+
+// Producers log into their own channel without locks or I/O; a background
+// writer thread takes a batch from each channel in turn, round after
+// round while any has events, and hands them to the sink, each channel's
+// in the order they were logged. The sink
+// runs on the writer thread only. When every ring is empty the writer
+// sleeps for a millisecond.
+//
+// A sink that throws is not called again: the writer keeps emptying the
+// rings, so no producer waits forever, and stop() rethrows the exception.
+class BJEventLog {
+public:
+    typedef std::function<void(int channel, const BJEvent* events, std::size_t n)> Sink;
+
+    static constexpr int         MaxChannels = 64;
+    static constexpr std::size_t RingEvents  = 64 * 1024;
+
+private:
+    Sink                         sink;
+    std::size_t                  ringEvents;
+    std::atomic<BJEventChannel*> channels[MaxChannels];     // owned, null until published
+    std::atomic<int>             channelCount;              // slots claimed
+    std::atomic<bool>            stopping;
+    std::atomic<std::uint64_t>   delivered;
+    std::exception_ptr           error;
+    std::thread                  writer;
+
+    std::size_t drainAll(std::vector<BJEvent>& buf);
+    void        run();
+
+public:
+    explicit BJEventLog(Sink s, std::size_t ring_events = RingEvents);
+    ~BJEventLog();                  // stop(), a sink's exception swallowed
+
+    BJEventLog(const BJEventLog&)            = delete;
+    BJEventLog& operator=(const BJEventLog&) = delete;
+
+    // A new channel for the calling producer; it lives as long as the log.
+    // Safe to call while other channels are logging. Throws
+    // std::length_error past MaxChannels.
+    BJEventChannel& openChannel(BJEventOverflow policy = BJEventOverflow::Drop);
+
+    // Delivers everything logged before the call, then ends the writer.
+    // Rethrows a sink's exception once.
+    void stop();
+
+    std::uint64_t getDelivered() const noexcept { return delivered.load(std::memory_order_relaxed); }
+    std::uint64_t getDropped() const noexcept;
+};
+
+// ---------------- RECORDER ----------------
+
+// Turns a game into events, through the recorder calls BJPlayRecordedRound
+// makes (BJRoundLog, BJHandHistoryWriter): beginRound after the bets,
+// action before each call on a hand, endRound after settlement. Cards are
+// read off the hands at each call, so every event follows what caused it.
+// An action is logged at the next call, once the game shows it was made.
+class BJEventRecorder {
+private:
+    static constexpr int MaxSeats = BJHistoryMaxSeats;
+
+    BJEventChannel& channel;
+    std::uint64_t   round;
+    std::int32_t    events;          // in the round so far
+    int             shuffles;
+    bool            dealt;           // the first two cards are out
+
+    int             seatCount;
+    std::uint8_t    seats[MaxSeats];
+    int             chipsBefore[MaxSeats];
+    int             sent[MaxSeats][2];       // cards logged per hand
+    int             dealerSent;
+    std::uint8_t    doubled[MaxSeats];
+
+    bool            pending;
+    int             pendingSeat;     // index into seats
+    int             pendingHand;
+    BJAction        pendingAction;
+    int             pendingBet;
+
+    void emit(BJEventType t, int seat, int hand, int code, int value) {
+        BJEvent e;
+        e.round = round;
+        e.type  = t;
+        e.seat  = (std::uint8_t)seat;
+        e.hand  = (std::uint8_t)hand;
+        e.code  = (std::uint8_t)code;
+        e.value = value;
+        channel.log(e);
+        ++events;
+    }
+
+    template <class Game>
+    void sync(const Game& g);
+
+public:
+    explicit BJEventRecorder(BJEventChannel& ch)
+        : channel(ch), round(0), events(0), shuffles(-1), dealt(false), seatCount(0),
+          dealerSent(0), pending(false), pendingSeat(0), pendingHand(0),
+          pendingAction(BJAction::Stand), pendingBet(0) {}
+
+    void setNextRound(std::uint64_t n) noexcept { round = n; }
+
+    template <class Game>
+    void beginRound(const Game& g);
+
+    template <class Game>
+    void action(const Game& g, BJAction a);
+
+    template <class Game>
+    void endRound(const Game& g, bool dealerPlayed);
+};
+
+template <class Game>
+void BJEventRecorder::beginRound(const Game& g)
+{
+    const auto& shoe = g.GetShoe();
+    if (shuffles < 0)
+        shuffles = shoe.getShuffleCount();
+
+    events     = 0;
+    dealt      = false;
+    dealerSent = 0;
+    pending    = false;
+
+    // the count the round is dealt at, as BJHandHistoryWriter takes it
+    const double tc = shoe.needsReshuffle() ? 0.0 : shoe.trueCount();
+    emit(BJEventType::RoundBegin, 0, 0, 0,
+         (std::int32_t)std::lround(std::min(std::max(tc * 10.0, -32000.0), 32000.0)));
+
+    seatCount = 0;
+    for (int i = 0; i < g.getPlayerCount() && i < MaxSeats; ++i) {
+        const BJPlayer& p = g.GetPlayer(i);
+        if (p.isBankrupt() || p.getBet() <= 0)
+            continue;
+        seats[seatCount]       = (std::uint8_t)i;
+        chipsBefore[seatCount] = p.getChips() + p.getBet();
+        sent[seatCount][0]     = 0;
+        sent[seatCount][1]     = 0;
+        doubled[seatCount]     = 0;
+        ++seatCount;
+        emit(BJEventType::Bet, i, 0, 0, p.getBet());
+    }
+}
+
+template <class Game>
+void BJEventRecorder::sync(const Game& g)
+{
+    if (g.GetShoe().getShuffleCount() != shuffles) {
+        shuffles = g.GetShoe().getShuffleCount();
+        emit(BJEventType::Reshuffle, 0, 0, 0, shuffles);
+    }
+
+    if (pending) {
+        pending = false;
+        const BJPlayer& p = g.GetPlayer(seats[pendingSeat]);
+        bool made = true;
+        if (pendingAction == BJAction::Split) {
+            made = p.hasSplitHand();
+            if (made) {
+                // the second card moves to the new hand; both then draw
+                sent[pendingSeat][0] = 1;
+                sent[pendingSeat][1] = 1;
+            }
+        } else if (pendingAction == BJAction::Double) {
+            made = (pendingHand == 0 ? p.getBet() : p.getSplitBet()) > pendingBet;
+            if (made)
+                doubled[pendingSeat] |= (std::uint8_t)(1u << pendingHand);
+        }
+        if (made)
+            emit(BJEventType::Action, seats[pendingSeat], pendingHand, (int)pendingAction, 0);
+    }
+
+    for (int s = 0; s < seatCount; ++s) {
+        const BJPlayer& p = g.GetPlayer(seats[s]);
+        const int hands = p.hasSplitHand() ? 2 : 1;
+        for (int h = 0; h < hands; ++h) {
+            const auto& cards = (h == 0 ? p.GetHand() : p.GetSplitHand()).GetCards();
+            for (int& i = sent[s][h]; i < (int)cards.size(); ++i) {
+                const BJEventType t = !dealt && i < 2 ? BJEventType::Deal : BJEventType::Draw;
+                emit(t, seats[s], h, cards[i].getCode(), 0);
+            }
+        }
+    }
+
+    const auto& dealer = g.GetDealer().GetHand().GetCards();
+    for (; dealerSent < (int)dealer.size(); ++dealerSent) {
+        const BJEventType t = !dealt && dealerSent < 2 ? BJEventType::Deal : BJEventType::DealerDraw;
+        emit(t, BJEventDealer, 0, dealer[dealerSent].getCode(), 0);
+    }
+    dealt = true;
+}
+
+template <class Game>
+void BJEventRecorder::action(const Game& g, BJAction a)
+{
+    sync(g);
+
+    const int idx = g.getCurrentPlayerIndex();
+    for (int s = 0; s < seatCount; ++s) {
+        if (seats[s] != idx)
+            continue;
+        const BJPlayer& p = g.GetPlayer(idx);
+        pending       = true;
+        pendingSeat   = s;
+        pendingHand   = g.getCurrentHandIndex();
+        pendingAction = a;
+        pendingBet    = pendingHand == 0 ? p.getBet() : p.getSplitBet();
+    }
+}
+
+template <class Game>
+void BJEventRecorder::endRound(const Game& g, bool)
+{
+    sync(g);
+
+    for (int s = 0; s < seatCount; ++s) {
+        const BJPlayer& p   = g.GetPlayer(seats[s]);
+        const int       net = p.getChips() - chipsBefore[s];
+        const int hands = p.hasSplitHand() ? 2 : 1;
+        for (int h = 0; h < hands; ++h) {
+            const BJHand& hand = h == 0 ? p.GetHand() : p.GetSplitHand();
+            const int outcome  = h == 0 ? p.getRoundOutcomeMain() : p.getRoundOutcomeSplit();
+            int code = outcome + 1;
+            if ((doubled[s] >> h) & 1)                         code |= 4;
+            if (hand.getStatus() == BJHandStatus::Surrendered) code |= 8;
+            emit(BJEventType::Settle, seats[s], h, code, net);
+        }
+    }
+
+    emit(BJEventType::RoundEnd, 0, 0, 0, events);
+    ++round;
+}
+
+// ---------------- HAND-HISTORY SINK ----------------
+
+// Rebuilds rounds from each channel's events and appends them to a
+// hand-history archive, numbered in the order they complete. A round whose
+// events do not add up (a producer dropped some on a full ring) is left
+// out and counted; one dropped whole never reaches the sink. Pass it to
+// BJEventLog with std::ref; it is only called from the writer thread.
+class BJHistoryEventSink {
+private:
+    struct Hand {
+        BJCard cards[BJMaxHandCards];
+        int    count;
+        int    outcome;
+        bool   doubled;
+        bool   surrendered;
+    };
+    struct Seat {
+        int  seat;
+        int  bet;
+        int  net;
+        int  handCount;
+        Hand hands[2];
+    };
+    struct Assembly {
+        bool          open    = false;
+        std::uint64_t round   = 0;
+        std::int32_t  events  = 0;
+        int           count10 = 0;
+        BJCard        dealer[BJMaxHandCards];
+        int           dealerCount = 0;
+        int           seatCount   = 0;
+        Seat          seats[BJHistoryMaxSeats];
+    };
+
+    BJHandHistoryWriter&  writer;
+    std::vector<Assembly> channels;
+    std::uint64_t         written;
+    std::uint64_t         lost;
+
+    void add(Assembly& a, const BJEvent& e);
+    void finish(Assembly& a, const BJEvent& e);
+
+public:
+    explicit BJHistoryEventSink(BJHandHistoryWriter& w) : writer(w), written(0), lost(0) {}
+
+    void operator()(int channel, const BJEvent* events, std::size_t n);
+
+    std::uint64_t getRoundsWritten() const noexcept { return written; }
+    std::uint64_t getRoundsLost()    const noexcept { return lost; }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+#include "BJExpectedValue.h"
+
+#include <algorithm>
+//---------------------------------------------------------------------------
+
+static int BestTotal(int hard, bool hasAce)
+{
+    return (hasAce && hard + 10 <= 21) ? hard + 10 : hard;
+}
+
+void BJEVSolver::beginQuery(int upcard, const BJShoeComposition& shoe)
+{
+    if (bestMemo.size() >= maxEntries)
+        bestMemo.clear();
+
+    if (mode == BJEVFast) {
+        fixedOdds = dealer.outcome(upcard, shoe);
+        basis     = shoe.key();
+    }
+}
+
+const BJDealerOutcome& BJEVSolver::dealerOdds(int upcard, const BJShoeComposition& shoe)
+{
+    return mode == BJEVFast ? fixedOdds : dealer.outcome(upcard, shoe);
+}
+
+double BJEVSolver::standValue(int total, int upcard, const BJShoeComposition& shoe)
+{
+    if (total > 21)
+        return -1.0;
+
+    const BJDealerOutcome& d = dealerOdds(upcard, shoe);
+
+    double ev = d.bust() - d.natural();
+    for (int t = 17; t <= 21; ++t) {
+        const double p = d.total(t);
+        ev += (total > t) ? p : (total < t ? -p : 0.0);
+    }
+    return ev;
+}
+
+double BJEVSolver::hitValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe)
+{
+    double hit = 0.0;
+    const double n = (double)shoe.size();
+    for (int cls = 1; cls <= 10; ++cls) {
+        const int count = shoe.count(cls);
+        if (count == 0)
+            continue;
+        shoe.remove(cls);
+        hit += (double)count / n * bestAfterDraw(hard + cls, hasAce || cls == 1, upcard, shoe);
+        shoe.add(cls);
+    }
+    return hit;
+}
+
+// Best of stand / hit for a hand that has already drawn, memoised by the
+// shoe that is left.
+double BJEVSolver::bestAfterDraw(int hard, bool hasAce, int upcard, BJShoeComposition& shoe)
+{
+    if (hard > 21)
+        return -1.0;
+
+    const int total = BestTotal(hard, hasAce);
+    const double stand = standValue(total, upcard, shoe);
+    if (total >= 21)
+        return stand;
+
+    const Key key = { shoe.key(), mode == BJEVFast ? basis : ~0ull,
+                      (std::uint16_t)((hard << 5) | (hasAce ? 16 : 0) | upcard) };
+    auto it = bestMemo.find(key);
+    if (it != bestMemo.end())
+        return it->second;
+
+    const double best = std::max(stand, hitValue(hard, hasAce, upcard, shoe));
+    bestMemo.emplace(key, best);
+    return best;
+}
+
+double BJEVSolver::doubleValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe)
+{
+    double ev = 0.0;
+    const double n = (double)shoe.size();
+    for (int cls = 1; cls <= 10; ++cls) {
+        const int count = shoe.count(cls);
+        if (count == 0)
+            continue;
+        shoe.remove(cls);
+        ev += (double)count / n * standValue(BestTotal(hard + cls, hasAce || cls == 1), upcard, shoe);
+        shoe.add(cls);
+    }
+    return 2.0 * ev;
+}
+
+// A split hand once it holds two cards: stand, hit or (with DAS) double.
+// A two-card 21 here is not a natural.
+double BJEVSolver::splitHandValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe)
+{
+    double best = bestAfterDraw(hard, hasAce, upcard, shoe);
+    if (rules.doubleAfterSplit() && BJDoubleAllowedOnTotal(rules, BestTotal(hard, hasAce)))
+        best = std::max(best, doubleValue(hard, hasAce, upcard, shoe));
+    return best;
+}
+
+// Expected number of finished split hands that did not / did catch another
+// pair card they could not resplit. pending hands still need their second
+// card; pairsLeft and shoeLeft follow the cards they have drawn.
+static void SplitHandCounts(int pending, int hands, int splitHands, int pairsLeft, int shoeLeft,
+                            double weight, double& plainHands, double& pairHands)
+{
+    if (pending == 0 || shoeLeft <= 0)
+        return;
+
+    const double q = (double)std::max(pairsLeft, 0) / (double)shoeLeft;
+    if (q > 0.0) {
+        if (hands < splitHands) {
+            SplitHandCounts(pending + 1, hands + 1, splitHands, pairsLeft - 1, shoeLeft - 1,
+                            weight * q, plainHands, pairHands);
+        } else {
+            pairHands += weight * q;
+            SplitHandCounts(pending - 1, hands, splitHands, pairsLeft - 1, shoeLeft - 1,
+                            weight * q, plainHands, pairHands);
+        }
+    }
+
+    plainHands += weight * (1.0 - q);
+    SplitHandCounts(pending - 1, hands, splitHands, pairsLeft, shoeLeft - 1,
+                    weight * (1.0 - q), plainHands, pairHands);
+}
+
+double BJEVSolver::splitValue(int card, int upcard, BJShoeComposition& shoe, int splitHands)
+{
+    const int pairs = shoe.count(card);
+    const int n     = shoe.size();
+    if (n - pairs <= 0)
+        return BJEVNotAllowed;
+
+    // one hand that drew a non-pair second card
+    double plain = 0.0;
+    for (int cls = 1; cls <= 10; ++cls) {
+        const int count = shoe.count(cls);
+        if (count == 0 || cls == card)
+            continue;
+        shoe.remove(cls);
+        plain += (double)count / (double)(n - pairs)
+               * splitHandValue(card + cls, card == 1 || cls == 1, upcard, shoe);
+        shoe.add(cls);
+    }
+
+    // one hand that drew the pair card with no resplit left
+    double pair = 0.0;
+    if (pairs > 0) {
+        shoe.remove(card);
+        pair = splitHandValue(2 * card, card == 1, upcard, shoe);
+        shoe.add(card);
+    }
+
+    double plainHands = 0.0, pairHands = 0.0;
+    SplitHandCounts(2, 2, std::max(splitHands, 2), pairs, n, 1.0, plainHands, pairHands);
+    return plainHands * plain + pairHands * pair;
+}
+
+double BJEVSolver::standEV(int total, int upcard, const BJShoeComposition& shoe)
+{
+    beginQuery(upcard, shoe);
+    return standValue(total, upcard, shoe);
+}
+
+double BJEVSolver::hitEV(int hard, bool hasAce, int upcard, const BJShoeComposition& shoe)
+{
+    beginQuery(upcard, shoe);
+    BJShoeComposition work = shoe;
+    return hitValue(hard, hasAce, upcard, work);
+}
+
+BJHandEV BJEVSolver::evaluateHand(int hard, bool hasAce, int pairCard, int upcard,
+                                  const BJShoeComposition& shoe, const BJEVOptions& options)
+{
+    beginQuery(upcard, shoe);
+
+    BJHandEV out;
+    BJShoeComposition work = shoe;
+
+    out.ev[(int)BJAction::Stand]  = standValue(BestTotal(hard, hasAce), upcard, work);
+    out.ev[(int)BJAction::Hit]    = hitValue(hard, hasAce, upcard, work);
+    out.ev[(int)BJAction::Double] = options.canDouble
+                                  ? doubleValue(hard, hasAce, upcard, work)
+                                  : BJEVNotAllowed;
+    out.ev[(int)BJAction::Split]  = (options.canSplit && pairCard > 0)
+                                  ? splitValue(pairCard, upcard, work, options.splitHands)
+                                  : BJEVNotAllowed;
+    out.ev[(int)BJAction::Surrender] = options.canSurrender ? -0.5 : BJEVNotAllowed;
+    return out;
+}
+
+BJHandEV BJEVSolver::evaluate(int c1, int c2, int upcard, const BJShoeComposition& shoe)
+{
+    const bool pair = (c1 == c2);
+
+    BJEVOptions options;
+    options.canDouble    = BJDoubleAllowedOnTotal(rules, BestTotal(c1 + c2, c1 == 1 || c2 == 1));
+    options.canSplit     = pair && rules.maxSplitHands() >= 2;
+    options.canSurrender = rules.lateSurrender();
+    options.splitHands   = (c1 == 1 && !rules.resplitAces()) ? 2 : rules.maxSplitHands();
+
+    return evaluateHand(c1 + c2, c1 == 1 || c2 == 1, pair ? c1 : 0, upcard, shoe, options);
+}
@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------
+#ifndef BJExpectedValueH
+#define BJExpectedValueH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "BJComposition.h"
+#include "BJDealerProbability.h"
+#include "BJDecisionManager.h"
+#include "BJRound.h"
+#include "BJRules.h"
+
+// ---------------- EXPECTED VALUES ----------------
+
+// Expected value of each decision, per unit of the hand's bet. Actions that
+// are not allowed hold BJEVNotAllowed.
+constexpr double BJEVNotAllowed = -1.0e9;
+
+struct BJHandEV {
+    double ev[BJActionCount];
+
+    double  of(BJAction a) const { return ev[(int)a]; }
+    BJAction best() const {
+        int b = 0;
+        for (int a = 1; a < BJActionCount; ++a)
+            if (ev[a] > ev[b]) b = a;
+        return (BJAction)b;
+    }
+    // Best of hit / stand, i.e. what to do when nothing else is allowed.
+    BJAction bestHitStand() const {
+        return ev[(int)BJAction::Hit] > ev[(int)BJAction::Stand] ? BJAction::Hit : BJAction::Stand;
+    }
+};
+
+// What the table accepts for the hand being decided, beyond hit and stand.
+struct BJEVOptions {
+    bool canDouble;
+    bool canSplit;
+    bool canSurrender;
+    int  splitHands;     // hands a split may grow to by resplitting (>= 2)
+};
+
+// How the dealer's odds follow the player's draws.
+//   BJEVExact: recomputed for the shoe left after every player card.
+//   BJEVFast:  taken from the shoe at the decision and held for the whole
+//              query; one dealer walk per query, within ~0.1% of exact.
+enum BJEVMode { BJEVExact, BJEVFast };
+
+// Composition-dependent EVs. Player draws always come out of the shoe;
+// player draw odds are not conditioned on the dealer's failed peek.
+//
+// Splits resplit up to splitHands, with the chance of drawing another pair
+// card tracked as pair cards leave; each split hand is then played on the
+// shoe left after the original pair, not the other hands' cards.
+//
+// Sub-results are memoised by remaining-shoe counts (and, in BJEVFast, by
+// the shoe the dealer's odds came from), so repeated and neighbouring
+// queries reuse them. Not thread-safe; use one instance per thread.
+class BJEVSolver {
+private:
+    struct Key {
+        std::uint64_t composition;
+        std::uint64_t basis;     // dealer-odds shoe in BJEVFast
+        std::uint16_t hand;      // hard total, ace flag, upcard
+        bool operator==(const Key& o) const {
+            return composition == o.composition && basis == o.basis && hand == o.hand;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t z = k.composition ^ (k.basis * 0x9E3779B97F4A7C15ull) ^ ((std::uint64_t)k.hand << 48);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return (std::size_t)(z ^ (z >> 31));
+        }
+    };
+
+    BJRuntimeRules      rules;
+    BJEVMode            mode;
+    std::size_t         maxEntries;
+    BJDealerProbability dealer;
+
+    std::unordered_map<Key, double, KeyHash> bestMemo;
+
+    // dealer odds held for the current query in BJEVFast
+    BJDealerOutcome fixedOdds;
+    std::uint64_t   basis;
+
+    void beginQuery(int upcard, const BJShoeComposition& shoe);
+    const BJDealerOutcome& dealerOdds(int upcard, const BJShoeComposition& shoe);
+
+    double standValue(int total, int upcard, const BJShoeComposition& shoe);
+    double hitValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe);
+    double bestAfterDraw(int hard, bool hasAce, int upcard, BJShoeComposition& shoe);
+    double doubleValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe);
+    double splitHandValue(int hard, bool hasAce, int upcard, BJShoeComposition& shoe);
+    double splitValue(int card, int upcard, BJShoeComposition& shoe, int splitHands);
+
+public:
+    template <class Rules>
+    explicit BJEVSolver(const Rules& r, BJEVMode m = BJEVExact, std::size_t max_entries = 1u << 20)
+        : rules(BJRuntimeRules::from(r)), mode(m), maxEntries(max_entries), dealer(r),
+          fixedOdds(), basis(~0ull) {}
+
+    const BJRuntimeRules& GetRules() const { return rules; }
+    BJEVMode              getMode()  const { return mode; }
+
+    // Standing on total against the upcard; shoe holds the unseen cards,
+    // i.e. without the upcard and the player's cards.
+    double standEV(int total, int upcard, const BJShoeComposition& shoe);
+
+    // Taking a card and then playing on with hit/stand only.
+    double hitEV(int hard, bool hasAce, int upcard, const BJShoeComposition& shoe);
+
+    // EVs for any hand: hard total, whether it holds an ace, and the rank
+    // class of a splittable pair (0 if none).
+    BJHandEV evaluateHand(int hard, bool hasAce, int pairCard, int upcard,
+                          const BJShoeComposition& shoe, const BJEVOptions& options);
+
+    // First-decision EVs for the two-card hand (c1, c2) (rank classes) on an
+    // unsplit hand, with the options the rules give it.
+    BJHandEV evaluate(int c1, int c2, int upcard, const BJShoeComposition& shoe);
+
+    std::size_t memoSize() const { return bestMemo.size(); }
+    void clear() { bestMemo.clear(); dealer.clear(); basis = ~0ull; }
+};
+
+// ---------------- GAME QUERIES ----------------
+
+// Unseen cards from the players' side: the undealt shoe plus the dealer's
+// hole card.
+template <class Game>
+BJShoeComposition BJUnseenComposition(const Game& g)
+{
+    BJShoeComposition unseen = g.GetShoe().getRemainingComposition();
+    const auto& dealerCards = g.GetDealer().GetHand().GetCards();
+    for (std::size_t i = 1; i < dealerCards.size(); ++i)
+        unseen.add(dealerCards[i]);
+    return unseen;
+}
+
+// EVs for the hand the game is waiting on, restricted to what
+// BJDecisionManager allows. BJBasicGame splits once, so no resplits.
+template <class Game>
+BJHandEV BJEvaluateCurrentHand(BJEVSolver& solver, const Game& g)
+{
+    const BJPlayer& p = g.GetCurrentPlayer();
+    const BJHand&   h = g.GetCurrentHand();
+
+    BJEVOptions options;
+    options.canDouble    = BJDecisionManager::canDoubleDown(p, g);
+    options.canSplit     = BJDecisionManager::canSplit(p, g);
+    options.canSurrender = BJDecisionManager::canSurrender(p, g);
+    options.splitHands   = 2;
+
+    const int upcard   = g.GetDealer().GetHand().GetCards()[0].getPoints();
+    const int pairCard = options.canSplit ? h.GetCards()[0].getPoints() : 0;
+
+    return solver.evaluateHand(h.getHardTotal(), h.getAceCount() > 0, pairCard, upcard,
+                               BJUnseenComposition(g), options);
+}
+
+//---------------------------------------------------------------------------
+#endif
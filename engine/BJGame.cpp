@@ -0,0 +1,7 @@
+//---------------------------------------------------------------------------
+#include "BJGame.h"
+//---------------------------------------------------------------------------
+
+// The app's instantiation is compiled once here rather than in every unit
+// that includes BJGame.h.
+template class BJBasicGame<BJRuntimeRules>;
@@ -0,0 +1,348 @@
+//---------------------------------------------------------------------------
+#ifndef BJGameH
+#define BJGameH
+//---------------------------------------------------------------------------
+
+#include <vector>
+
+#include "BJDealer.h"
+#include "BJPlayer.h"
+#include "BJRules.h"
+#include "BJSettlement.h"
+#include "BJShoe.h"
+
+// ---------------- GAME ----------------
+
+// Templated on the rules policy (see BJRules.h) and the shoe's shuffle
+// engine. The app plays BJGame, the runtime-rules instantiation below;
+// simulators instantiate BJBasicGame<BJRulesS17> etc. directly.
+template <class Rules, class Engine = BJXoshiro256ss>
+class BJBasicGame {
+public:
+    typedef Rules                RulesType;
+    typedef BJBasicShoe<Engine>  ShoeType;
+
+private:
+    Rules rules;
+    ShoeType shoe;
+    BJDealer dealer;
+    std::vector<BJPlayer> players;
+    int current_player_index;
+    int current_hand_index;
+
+    BJPayoutTable payoutTable;
+
+    // Scratch buffers for settleBets(), sized once for two hands a player.
+    std::vector<BJSettleRecord> settleRecords;
+    std::vector<BJSettleResult> settleResults;
+
+public:
+    BJBasicGame(int player_count, int player_initial_chips,
+                int deck_count = 1, double penetration = ShoeType::DefaultPenetration,
+                const Rules& r = Rules())
+        : rules(r), shoe(deck_count, penetration), dealer(), players(),
+          current_player_index(0), current_hand_index(0),
+          payoutTable(r.payoutTable())
+    {
+        for (int i = 0; i < player_count; ++i) {
+            players.emplace_back(i, player_initial_chips);
+        }
+        settleRecords.reserve(2 * player_count);
+        settleResults.resize(2 * player_count);
+    }
+
+    const Rules& GetRules() const noexcept { return rules; }
+
+    ShoeType&       GetShoe()       noexcept { return shoe; }
+    const ShoeType& GetShoe() const noexcept { return shoe; }
+
+    BJDealer&       GetDealer()       noexcept { return dealer; }
+    const BJDealer& GetDealer() const noexcept { return dealer; }
+
+    BJPlayer&       GetCurrentPlayer()       { return players[current_player_index]; }
+    const BJPlayer& GetCurrentPlayer() const { return players[current_player_index]; }
+
+    BJPlayer&       GetPlayer(int i)       { return players[i]; }
+    const BJPlayer& GetPlayer(int i) const { return players[i]; }
+
+    const BJPayoutTable& GetPayoutTable() const noexcept { return payoutTable; }
+    void setPayoutTable(const BJPayoutTable& t) noexcept { payoutTable = t; }
+
+    int  getPlayerCount()        const { return (int)players.size(); }
+    int  getCurrentPlayerIndex() const { return current_player_index; }
+    int  getCurrentHandIndex()   const { return current_hand_index; }
+
+    BJHand&       GetCurrentHand() {
+        BJPlayer& p = players[current_player_index];
+        return (current_hand_index == 0 ? p.GetHand() : p.GetSplitHand());
+    }
+    const BJHand& GetCurrentHand() const {
+        const BJPlayer& p = players[current_player_index];
+        return (current_hand_index == 0 ? p.GetHand() : p.GetSplitHand());
+    }
+
+    // True when the rules have the dealer check an ace or ten upcard for
+    // blackjack before the players act.
+    bool dealerShouldPeek() const {
+        const auto& cards = dealer.GetHand().GetCards();
+        if (!rules.dealerPeek() || cards.size() < 2)
+            return false;
+        return cards[0].isTen() || cards[0].isAce();
+    }
+
+    void startRound();
+    bool advanceTurn();
+    void resolveDealerHand();
+    void resetForNextRound();
+    void settleBets();
+
+    // ---------------- PLAYER ACTIONS ----------------
+
+    // Engine-side versions of the table buttons, applied to the current
+    // hand. Legality is BJDecisionManager's job; only chip shortfalls are
+    // reported (false).
+    void hitCurrentHand();
+    bool standCurrentHand();       // returns advanceTurn()
+    bool doubleCurrentHand();      // doubles the bet and deals one card
+    bool splitCurrentHand();       // splits the main hand, one new card each
+    void surrenderCurrentHand();
+
+    // Any hand still needing the dealer to play out (not busted,
+    // surrendered or an unsplit natural).
+    bool liveHandsRemain() const;
+};
+
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::startRound()
+{
+    resetForNextRound();
+
+    for (auto& p : players) {
+        if (p.isBankrupt() || p.getBet() <= 0)
+            continue;
+        shoe.dealCardTo(p.GetHand());
+        shoe.dealCardTo(p.GetHand());
+    }
+
+    shoe.dealCardTo(dealer.GetHand());
+    shoe.dealCardTo(dealer.GetHand());
+
+    current_player_index = 0;
+    current_hand_index   = 0;
+
+    for (int i = 0; i < (int)players.size(); ++i) {
+        BJPlayer& p = players[i];
+        if (!p.isBankrupt() && p.getBet() > 0 && p.GetHand().size() > 0) {
+            current_player_index = i;
+            break;
+        }
+    }
+}
+
+template <class Rules, class Engine>
+bool BJBasicGame<Rules, Engine>::advanceTurn()
+{
+    BJPlayer& p = players[current_player_index];
+
+    if (current_hand_index == 0 &&
+        p.hasSplitHand() &&
+        p.getSplitBet() > 0 &&
+        !p.isBankrupt())
+    {
+        current_hand_index = 1;
+        return true;
+    }
+
+    current_hand_index = 0;
+    int n = (int)players.size();
+    for (int idx = current_player_index + 1; idx < n; ++idx) {
+        BJPlayer& np = players[idx];
+        if (!np.isBankrupt() && np.getBet() > 0 && np.GetHand().size() > 0) {
+            current_player_index = idx;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::resolveDealerHand()
+{
+    BJHand& h = dealer.GetHand();
+    while (BJDealerMustHit(rules, h)) {
+        shoe.dealCardTo(h);
+    }
+}
+
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::resetForNextRound()
+{
+    dealer.clearHand();
+    for (auto& p : players) {
+        p.clearHands();
+    }
+
+    shoe.collectRound();
+    if (shoe.needsReshuffle()) {
+        shoe.reshuffle();
+    }
+
+    current_player_index = 0;
+    current_hand_index   = 0;
+}
+
+// Every hand with money on it becomes one flat record; BJSettleHands
+// classifies them all against the dealer and the payout table, then the
+// results are written back in the same order.
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::settleBets()
+{
+    const BJHand& dh = dealer.GetHand();
+
+    settleRecords.clear();
+    for (auto& p : players) {
+        p.setRoundOutcomeMain(0);
+        p.setRoundOutcomeSplit(0);
+
+        if (p.getBet() > 0) {
+            const BJHand& h = p.GetHand();
+            std::uint8_t flags = BJSettleNone;
+            if (!p.hasSplitHand() && h.isBlackjack())
+                flags |= BJSettleNatural;
+            if (h.getStatus() == BJHandStatus::Surrendered)
+                flags |= BJSettleSurrendered;
+            settleRecords.push_back({ (std::uint8_t)h.value(), flags, p.getBet() });
+        }
+
+        if (p.hasSplitHand() && p.getSplitBet() > 0) {
+            const BJHand& h2 = p.GetSplitHand();
+            std::uint8_t flags = BJSettleNone;
+            if (h2.getStatus() == BJHandStatus::Surrendered)
+                flags |= BJSettleSurrendered;
+            settleRecords.push_back({ (std::uint8_t)h2.value(), flags, p.getSplitBet() });
+        }
+    }
+
+    BJSettleHands(settleRecords.data(), (int)settleRecords.size(),
+                  dh.value(), dh.isBlackjack(), payoutTable, settleResults.data());
+
+    int r = 0;
+    for (auto& p : players) {
+        if (p.getBet() > 0) {
+            p.adjustChips(settleResults[r].payout);
+            p.setRoundOutcomeMain(settleResults[r].outcome);
+            ++r;
+        }
+        if (p.hasSplitHand() && p.getSplitBet() > 0) {
+            p.adjustChips(settleResults[r].payout);
+            p.setRoundOutcomeSplit(settleResults[r].outcome);
+            ++r;
+        }
+    }
+}
+
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::hitCurrentHand()
+{
+    BJPlayer& p = players[current_player_index];
+    shoe.dealCardTo(GetCurrentHand());
+    p.markActionOnHand(current_hand_index);
+}
+
+template <class Rules, class Engine>
+bool BJBasicGame<Rules, Engine>::standCurrentHand()
+{
+    players[current_player_index].markActionOnHand(current_hand_index);
+    return advanceTurn();
+}
+
+template <class Rules, class Engine>
+bool BJBasicGame<Rules, Engine>::doubleCurrentHand()
+{
+    BJPlayer& p = players[current_player_index];
+    int bet = (current_hand_index == 0 ? p.getBet() : p.getSplitBet());
+    if (bet <= 0 || p.getChips() < bet)
+        return false;
+
+    p.adjustChips(-bet);
+    if (current_hand_index == 0)
+        p.setBet(bet * 2);
+    else
+        p.setSplitBet(bet * 2);
+
+    p.markActionOnHand(current_hand_index);
+    shoe.dealCardTo(GetCurrentHand());
+    return true;
+}
+
+template <class Rules, class Engine>
+bool BJBasicGame<Rules, Engine>::splitCurrentHand()
+{
+    BJPlayer& p = players[current_player_index];
+    BJHand&   h = p.GetHand();
+
+    int bet = p.getBet();
+    if (h.size() != 2 || bet <= 0 || p.getChips() < bet)
+        return false;
+
+    BJCard c1 = h.GetCards()[0];
+    BJCard c2 = h.GetCards()[1];
+
+    h.clear();
+    h.addCard(c1);
+
+    BJHand& sh = p.GetSplitHand();
+    sh.clear();
+    sh.addCard(c2);
+    p.setHasSplit(true);
+
+    p.adjustChips(-bet);
+    p.setSplitBet(bet);
+
+    shoe.dealCardTo(h);
+    shoe.dealCardTo(sh);
+
+    // without double-after-split both hands count as having acted
+    if (!rules.doubleAfterSplit()) {
+        p.markActionOnHand(0);
+        p.markActionOnHand(1);
+    }
+    return true;
+}
+
+template <class Rules, class Engine>
+void BJBasicGame<Rules, Engine>::surrenderCurrentHand()
+{
+    GetCurrentHand().setStatus(BJHandStatus::Surrendered);
+    players[current_player_index].markActionOnHand(current_hand_index);
+}
+
+template <class Rules, class Engine>
+bool BJBasicGame<Rules, Engine>::liveHandsRemain() const
+{
+    for (const auto& p : players) {
+        if (p.getBet() > 0) {
+            const BJHand& h = p.GetHand();
+            bool natural = !p.hasSplitHand() && h.isBlackjack();
+            if (!h.isBust() && !natural && h.getStatus() != BJHandStatus::Surrendered)
+                return true;
+        }
+        if (p.hasSplitHand() && p.getSplitBet() > 0) {
+            const BJHand& h2 = p.GetSplitHand();
+            if (!h2.isBust() && h2.getStatus() != BJHandStatus::Surrendered)
+                return true;
+        }
+    }
+    return false;
+}
+
+extern template class BJBasicGame<BJRuntimeRules>;
+
+// The app's game: rules chosen at run time from Settings.
+class BJGame : public BJBasicGame<BJRuntimeRules> {
+public:
+    using BJBasicGame<BJRuntimeRules>::BJBasicGame;
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,203 @@
+//---------------------------------------------------------------------------
+#include "BJGoalOdds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+//---------------------------------------------------------------------------
+
+// Largest bankroll, in steps, the exact solver will take on.
+static const std::size_t BJGoalMaxStates = std::size_t(1) << 21;
+
+double BJRoundDistribution::mean() const
+{
+    double m = 0.0;
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        m += p[i] * (double)(i - BJNetTenthsMax) / 10.0;
+    return m;
+}
+
+double BJRoundDistribution::variance() const
+{
+    const double m = mean();
+    double v = 0.0;
+    for (int i = 0; i < BJNetOutcomes; ++i) {
+        const double x = (double)(i - BJNetTenthsMax) / 10.0 - m;
+        v += p[i] * x * x;
+    }
+    return v;
+}
+
+int BJRoundDistribution::granularity() const
+{
+    int g = 0;
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        if (p[i] > 0.0 && i != BJNetTenthsMax)
+            g = std::gcd(g, std::abs(i - BJNetTenthsMax));
+    return g > 0 ? g : 10;
+}
+
+void BJRoundHistogram::addSeat(double net)
+{
+    BJSimStats::addSeat(net);
+
+    int tenths = (int)std::lround(net * 10.0);
+    tenths = std::max(-BJNetTenthsMax, std::min(BJNetTenthsMax, tenths));
+    ++counts[tenths + BJNetTenthsMax];
+}
+
+void BJRoundHistogram::merge(const BJRoundHistogram& o)
+{
+    BJSimStats::merge(o);
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        counts[i] += o.counts[i];
+}
+
+BJRoundDistribution BJRoundHistogram::distribution() const
+{
+    BJRoundDistribution d;
+    std::uint64_t total = 0;
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        total += counts[i];
+    if (total == 0)
+        return d;
+
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        d.p[i] = (double)counts[i] / (double)total;
+    return d;
+}
+
+BJRoundDistribution BJBasicStrategyRounds(const BJRuntimeRules& rules, int deckCount,
+                                          std::uint64_t rounds, std::uint64_t seed)
+{
+    BJSimConfig cfg;
+    cfg.rounds    = rounds;
+    cfg.deckCount = deckCount;
+    cfg.seed      = seed;
+
+    const BJStrategyTable table = BJBasicStrategyFor(rules, deckCount);
+    return BJMeasureRounds<BJRuntimeRules>(cfg, BJBasicStrategy(table));
+}
+
+BJGoalOdds BJGoalOddsExact(const BJRoundDistribution& d, double chips, double goal, double bet)
+{
+    if (!(bet > 0.0))
+        throw std::invalid_argument("Bet must be positive");
+
+    const int    g    = d.granularity();
+    const int    band = BJNetTenthsMax / g;
+    const double step = bet * (double)g / 10.0;
+
+    // bankroll in steps: ruined below `ruin`, done at `top`
+    const long long ruin = (long long)std::ceil(10.0 / (double)g - 1e-9);
+    const long long top  = (long long)std::ceil(goal / step - 1e-9);
+    const long long x0   = (long long)std::floor(chips / step + 1e-9);
+
+    if (x0 >= top) return BJGoalOdds{ 1.0, 0.0 };
+    if (x0 < ruin) return BJGoalOdds{ 0.0, 0.0 };
+
+    const long long states = top - ruin;
+    if ((std::size_t)states > BJGoalMaxStates)
+        throw std::length_error("Goal too far from the bet for the exact solver");
+
+    const int n     = (int)states;
+    const int width = 2 * band + 1;
+
+    // row j is bankroll ruin + j; column offsets -band..band around it
+    std::vector<double> a((std::size_t)n * width, 0.0);
+    std::vector<double> reach(n, 0.0), rounds(n, 1.0);
+    auto at = [&](int row, int col) -> double& {
+        return a[(std::size_t)row * width + (col - row + band)];
+    };
+
+    for (int j = 0; j < n; ++j) {
+        at(j, j) = 1.0;
+        for (int k = -band; k <= band; ++k) {
+            const double p = d.p[k * g + BJNetTenthsMax];
+            if (p == 0.0)
+                continue;
+            const int to = j + k;
+            if (to >= n)
+                reach[j] += p;
+            else if (to >= 0)
+                at(j, to) -= p;
+        }
+    }
+
+    // banded elimination; the matrix is diagonally dominant, so no pivoting
+    for (int j = 0; j < n; ++j) {
+        const double pivot = at(j, j);
+        const int last = std::min(j + band, n - 1);
+        for (int i = j + 1; i <= last; ++i) {
+            const double f = at(i, j) / pivot;
+            if (f == 0.0)
+                continue;
+            for (int c = j; c <= last; ++c)
+                at(i, c) -= f * at(j, c);
+            reach[i]  -= f * reach[j];
+            rounds[i] -= f * rounds[j];
+        }
+    }
+    for (int j = n - 1; j >= 0; --j) {
+        const int last = std::min(j + band, n - 1);
+        for (int c = j + 1; c <= last; ++c) {
+            reach[j]  -= at(j, c) * reach[c];
+            rounds[j] -= at(j, c) * rounds[c];
+        }
+        reach[j]  /= at(j, j);
+        rounds[j] /= at(j, j);
+    }
+
+    const int start = (int)(x0 - ruin);
+    return BJGoalOdds{ std::min(std::max(reach[start], 0.0), 1.0), rounds[start] };
+}
+
+double BJGoalReachDiffusion(const BJRoundDistribution& d, double chips, double goal, double bet)
+{
+    const double x = (chips - bet) / bet;      // bets above ruin
+    const double t = (goal - bet) / bet;
+    if (x >= t)   return 1.0;
+    if (x < 0.0)  return 0.0;
+
+    const double mu = d.mean();
+    const double s2 = d.variance();
+    if (s2 <= 0.0)
+        return mu > 0.0 ? 1.0 : 0.0;
+
+    const double k = -2.0 * mu / s2;
+    if (std::fabs(k * t) < 1e-9)
+        return x / t;
+    return std::expm1(k * x) / std::expm1(k * t);
+}
+
+double BJGoalSample::standardError() const
+{
+    if (paths == 0)
+        return 0.0;
+    const double p = probability();
+    return std::sqrt(p * (1.0 - p) / (double)paths);
+}
+
+BJRoundSampler::BJRoundSampler(const BJRoundDistribution& d)
+{
+    std::vector<int> order;
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        if (d.p[i] > 0.0)
+            order.push_back(i);
+    std::sort(order.begin(), order.end(), [&d](int a, int b) { return d.p[a] > d.p[b]; });
+
+    double sum = 0.0;
+    for (int i : order) {
+        sum += d.p[i];
+        cdf.push_back(sum);
+        net.push_back((double)(i - BJNetTenthsMax) / 10.0);
+    }
+    if (cdf.empty()) {
+        cdf.push_back(1.0);
+        net.push_back(0.0);
+    }
+}
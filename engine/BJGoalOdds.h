@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------
+#ifndef BJGoalOddsH
+#define BJGoalOddsH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+#include "BJRandom.h"
+#include "BJRules.h"
+#include "BJSimulator.h"
+
+// ---------------- ROUND DISTRIBUTION ----------------
+
+// A seat-round nets between -4 bets (split and double both hands) and +4,
+// always in tenths of the bet (the payout tables are in tenths).
+constexpr int BJNetTenthsMax = 40;
+constexpr int BJNetOutcomes  = 2 * BJNetTenthsMax + 1;
+
+// Probability of each net result, indexed by tenths + BJNetTenthsMax.
+struct BJRoundDistribution {
+    double p[BJNetOutcomes] = {};
+
+    double mean()     const;    // in bets
+    double variance() const;    // in bets squared
+
+    // Largest step, in tenths, that every possible result is a multiple of
+    // (5 for 3:2 games, 2 for 6:5).
+    int granularity() const;
+};
+
+// BJSimStats that also histograms every seat's net result.
+struct BJRoundHistogram : BJSimStats {
+    std::uint64_t counts[BJNetOutcomes] = {};
+
+    void addSeat(double net);
+    void merge(const BJRoundHistogram& o);
+
+    BJRoundDistribution distribution() const;
+};
+
+// Flat-bet simulation of a strategy, kept as a round distribution.
+template <class Rules, class Strategy>
+BJRoundDistribution BJMeasureRounds(const BJSimConfig& cfg, const Strategy& strategy)
+{
+    typedef BJXoshiro256ss Engine;
+    const BJRoundHistogram h = BJRunTables<Engine, BJRoundHistogram>(cfg,
+        [&cfg, &strategy](int, const Engine& engine, std::uint64_t rounds, BJRoundHistogram& stats) {
+            BJSimulateTable<Rules>(cfg, engine, rounds, strategy, stats);
+        });
+    return h.distribution();
+}
+
+// Basic strategy for the rules and deck count, over `rounds` rounds.
+BJRoundDistribution BJBasicStrategyRounds(const BJRuntimeRules& rules, int deckCount,
+                                          std::uint64_t rounds = 1000000, std::uint64_t seed = 1);
+
+// ---------------- GOAL ODDS ----------------
+
+// Start with `chips`, bet `bet` every round, stop at `goal` or once a full
+// bet can no longer be covered. Doubles and splits are assumed affordable.
+struct BJGoalOdds {
+    double reach;            // probability of getting to the goal first
+    double expectedRounds;   // until either happens
+};
+
+// Exact for the distribution: solves the first-passage equations over the
+// bankroll in steps of bet x granularity / 10 with a banded elimination.
+// Cost is linear in goal / bet.
+BJGoalOdds BJGoalOddsExact(const BJRoundDistribution& d, double chips, double goal, double bet);
+
+// Brownian approximation from the mean and variance alone; closed form.
+double BJGoalReachDiffusion(const BJRoundDistribution& d, double chips, double goal, double bet);
+
+// ---------------- MONTE CARLO CHECK ----------------
+
+// A chip-bet policy is anything with
+//     double bet(double chips) const;
+// A path is ruined once the bet is not positive or exceeds the chips.
+struct BJFlatChips {
+    double amount;
+    double bet(double) const { return amount; }
+};
+
+struct BJGoalSample {
+    std::uint64_t paths      = 0;
+    std::uint64_t reached    = 0;
+    std::uint64_t unfinished = 0;     // stopped at maxRounds
+    double        sumRounds  = 0.0;
+    double        seconds    = 0.0;
+
+    void merge(const BJGoalSample& o) {
+        paths      += o.paths;
+        reached    += o.reached;
+        unfinished += o.unfinished;
+        sumRounds  += o.sumRounds;
+    }
+
+    double probability()   const { return paths ? (double)reached / (double)paths : 0.0; }
+    double standardError() const;
+    double meanRounds()    const { return paths ? sumRounds / (double)paths : 0.0; }
+};
+
+// Samples each round from the distribution. Paths are split into fixed
+// chunks, each with its own substream of seed, so the result does not
+// depend on the thread count (0 = hardware threads).
+template <class ChipPolicy>
+BJGoalSample BJGoalReachMonteCarlo(const BJRoundDistribution& d, double chips, double goal,
+                                   const ChipPolicy& policy, std::uint64_t paths,
+                                   std::uint64_t seed, unsigned threads = 0,
+                                   std::uint64_t maxRounds = 1000000);
+
+//---------------------------------------------------------------------------
+// Monte Carlo implementation
+//---------------------------------------------------------------------------
+
+// Cumulative table over the possible outcomes, most likely first, so the
+// linear search usually stops after one or two steps.
+struct BJRoundSampler {
+    std::vector<double> cdf;
+    std::vector<double> net;     // in bets
+
+    explicit BJRoundSampler(const BJRoundDistribution& d);
+
+    template <class Engine>
+    double draw(Engine& rng) const {
+        const double u = BJRandomUnitDouble(rng);
+        std::size_t i = 0;
+        while (i + 1 < cdf.size() && u >= cdf[i])
+            ++i;
+        return net[i];
+    }
+};
+
+template <class ChipPolicy>
+BJGoalSample BJGoalReachMonteCarlo(const BJRoundDistribution& d, double chips, double goal,
+                                   const ChipPolicy& policy, std::uint64_t paths,
+                                   std::uint64_t seed, unsigned threads, std::uint64_t maxRounds)
+{
+    typedef BJXoshiro256ss Engine;
+    const BJRoundSampler sampler(d);
+
+    BJSimConfig cfg;
+    cfg.rounds  = paths;
+    cfg.tables  = 64;
+    cfg.threads = (int)threads;
+    cfg.seed    = seed;
+
+    return BJRunTables<Engine, BJGoalSample>(cfg,
+        [&](int, const Engine& engine, std::uint64_t count, BJGoalSample& out) {
+            Engine rng = engine;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                double bank = chips;
+                std::uint64_t r = 0;
+                for (; r < maxRounds && bank < goal; ++r) {
+                    const double b = policy.bet(bank);
+                    if (b <= 0.0 || b > bank)
+                        break;
+                    bank += b * sampler.draw(rng);
+                }
+                ++out.paths;
+                out.sumRounds += (double)r;
+                if (bank >= goal)
+                    ++out.reached;
+                else if (r == maxRounds)
+                    ++out.unfinished;
+            }
+        });
+}
+
+//---------------------------------------------------------------------------
+#endif
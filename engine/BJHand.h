@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------
+#ifndef BJHandH
+#define BJHandH
+//---------------------------------------------------------------------------
+
+#include <string>
+
+#include "BJCard.h"
+#include "BJCardArray.h"
+
+// ---------------- HAND ----------------
+
+class BJHand {
+public:
+    typedef BJCardArray<BJMaxHandCards> CardList;
+
+private:
+    CardList hand;
+    BJHandStatus status;
+
+    // Running totals maintained by addCard(): every ace counted as 1 in
+    // hardTotal, so the best total is hardTotal or hardTotal + 10.
+    int hardTotal;
+    int aceCount;
+public:
+    BJHand() : status(BJHandStatus::Active), hardTotal(0), aceCount(0) {}
+
+    void addCard(const BJCard& c) {
+        hand.push_back(c);
+
+        hardTotal += c.getPoints();
+        aceCount  += c.isAce();
+    }
+    int  size() const             { return (int)hand.size(); }
+
+    int  getHardTotal() const { return hardTotal; }
+    int  getAceCount()  const { return aceCount; }
+
+    bool isSoft() const { return aceCount > 0 && hardTotal + 10 <= 21; }
+
+    int value() const { return isSoft() ? hardTotal + 10 : hardTotal; }
+
+    bool isBust()      const { return hardTotal > 21; }
+    bool isBlackjack() const { return hand.size() == 2 && value() == 21; }
+
+    void clear() {
+        hand.clear();
+        status    = BJHandStatus::Active;
+        hardTotal = 0;
+        aceCount  = 0;
+    }
+
+    const CardList& GetCards() const { return hand; }
+
+    BJHandStatus getStatus() const { return status; }
+    void setStatus(BJHandStatus s) { status = s; }
+
+    std::string toString() const {
+        std::string output;
+        for (const auto& card : hand) {
+            output += card.toString() + "\n";
+        }
+        return output;
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
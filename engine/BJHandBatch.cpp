@@ -0,0 +1,472 @@
+//---------------------------------------------------------------------------
+#include "BJHandBatch.h"
+
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BJ_SIMD_X86 1
+#include <immintrin.h>
+#endif
+//---------------------------------------------------------------------------
+
+// Every lane holds a small non-negative byte (hard totals stay below 32),
+// so the signed byte compares are safe throughout.
+
+// ---------------- SIMD LEVEL ----------------
+
+const char* BJSimdLevelName(BJSimdLevel level)
+{
+    static const char* names[(int)BJSimdLevel::Count] = { "scalar", "sse4.1", "avx2" };
+    return names[(int)level];
+}
+
+BJSimdLevel BJBestSimdLevel()
+{
+#ifdef BJ_SIMD_X86
+    static const BJSimdLevel best = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))   return BJSimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return BJSimdLevel::SSE41;
+        return BJSimdLevel::Scalar;
+    }();
+    return best;
+#else
+    return BJSimdLevel::Scalar;
+#endif
+}
+
+// ---------------- SCALAR KERNELS ----------------
+
+// Each works on hands [from, to); the vector kernels hand them their tail.
+
+static void AddCardsScalar(std::uint8_t* hard, std::uint8_t* aces, std::uint8_t* cards,
+                           const std::uint8_t* points, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        const std::uint8_t p = points[i];
+        hard[i]  += p;
+        aces[i]  += (p == 1);
+        cards[i] += (p != 0);
+    }
+}
+
+static inline int ValueScalar(int hard, int aces)
+{
+    return (aces > 0 && hard <= 11) ? hard + 10 : hard;
+}
+
+static void ValuesScalar(const std::uint8_t* hard, const std::uint8_t* aces,
+                         std::uint8_t* out, int from, int to)
+{
+    for (int i = from; i < to; ++i)
+        out[i] = (std::uint8_t)ValueScalar(hard[i], aces[i]);
+}
+
+static void StatusScalar(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                         std::uint8_t* out, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        const int v = ValueScalar(hard[i], aces[i]);
+        out[i] = (std::uint8_t)(((aces[i] > 0 && hard[i] <= 11) ? BJBatchSoft : 0) |
+                                (hard[i] > 21 ? BJBatchBust : 0) |
+                                ((cards[i] == 2 && v == 21) ? BJBatchBlackjack : 0));
+    }
+}
+
+static void DealerMustHitScalar(const std::uint8_t* hard, const std::uint8_t* aces, bool h17,
+                                std::uint8_t* out, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        const bool soft = aces[i] > 0 && hard[i] <= 11;
+        const int  v    = soft ? hard[i] + 10 : hard[i];
+        out[i] = (std::uint8_t)(v < 17 || (h17 && v == 17 && soft));
+    }
+}
+
+static void DealerScoresScalar(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                               std::uint8_t* out, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        const int v = ValueScalar(hard[i], aces[i]);
+        out[i] = (std::uint8_t)BJDealerScore(v, cards[i] == 2 && v == 21);
+    }
+}
+
+static void ClassifyScalar(const std::uint8_t* hard, const std::uint8_t* aces,
+                           const std::uint8_t* flags, const std::uint8_t* dealer,
+                           std::uint8_t* out, int from, int to)
+{
+    for (int i = from; i < to; ++i) {
+        const BJSettleRecord r = { (std::uint8_t)ValueScalar(hard[i], aces[i]), flags[i], 0 };
+        out[i] = (std::uint8_t)BJClassifyHand(r, dealer[i]);
+    }
+}
+
+#ifdef BJ_SIMD_X86
+
+// ---------------- SSE4.1 KERNELS (16 HANDS) ----------------
+
+#define BJ_SSE41 __attribute__((target("sse4.1")))
+
+BJ_SSE41 static inline __m128i SoftSSE(__m128i h, __m128i a)
+{
+    return _mm_andnot_si128(_mm_cmpeq_epi8(a, _mm_setzero_si128()),
+                            _mm_cmpgt_epi8(_mm_set1_epi8(12), h));
+}
+
+BJ_SSE41 static inline __m128i ValueSSE(__m128i h, __m128i soft)
+{
+    return _mm_add_epi8(h, _mm_and_si128(soft, _mm_set1_epi8(10)));
+}
+
+BJ_SSE41 static int AddCardsSSE(std::uint8_t* hard, std::uint8_t* aces, std::uint8_t* cards,
+                                const std::uint8_t* points, int n)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i p = _mm_loadu_si128((const __m128i*)(points + i));
+        __m128i h = _mm_loadu_si128((const __m128i*)(hard + i));
+        __m128i a = _mm_loadu_si128((const __m128i*)(aces + i));
+        __m128i c = _mm_loadu_si128((const __m128i*)(cards + i));
+        h = _mm_add_epi8(h, p);
+        a = _mm_sub_epi8(a, _mm_cmpeq_epi8(p, one));
+        c = _mm_add_epi8(c, _mm_andnot_si128(_mm_cmpeq_epi8(p, _mm_setzero_si128()), one));
+        _mm_storeu_si128((__m128i*)(hard + i), h);
+        _mm_storeu_si128((__m128i*)(aces + i), a);
+        _mm_storeu_si128((__m128i*)(cards + i), c);
+    }
+    return i;
+}
+
+BJ_SSE41 static int ValuesSSE(const std::uint8_t* hard, const std::uint8_t* aces,
+                              std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i h = _mm_loadu_si128((const __m128i*)(hard + i));
+        const __m128i a = _mm_loadu_si128((const __m128i*)(aces + i));
+        _mm_storeu_si128((__m128i*)(out + i), ValueSSE(h, SoftSSE(h, a)));
+    }
+    return i;
+}
+
+BJ_SSE41 static int StatusSSE(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                              std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i h    = _mm_loadu_si128((const __m128i*)(hard + i));
+        const __m128i a    = _mm_loadu_si128((const __m128i*)(aces + i));
+        const __m128i c    = _mm_loadu_si128((const __m128i*)(cards + i));
+        const __m128i soft = SoftSSE(h, a);
+        const __m128i v    = ValueSSE(h, soft);
+        const __m128i bust = _mm_cmpgt_epi8(h, _mm_set1_epi8(21));
+        const __m128i bj   = _mm_and_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(2)),
+                                           _mm_cmpeq_epi8(v, _mm_set1_epi8(21)));
+        __m128i s = _mm_and_si128(soft, _mm_set1_epi8(BJBatchSoft));
+        s = _mm_or_si128(s, _mm_and_si128(bust, _mm_set1_epi8(BJBatchBust)));
+        s = _mm_or_si128(s, _mm_and_si128(bj,   _mm_set1_epi8(BJBatchBlackjack)));
+        _mm_storeu_si128((__m128i*)(out + i), s);
+    }
+    return i;
+}
+
+BJ_SSE41 static int DealerMustHitSSE(const std::uint8_t* hard, const std::uint8_t* aces, bool h17,
+                                     std::uint8_t* out, int n)
+{
+    const __m128i soft17 = h17 ? _mm_set1_epi8(-1) : _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i h    = _mm_loadu_si128((const __m128i*)(hard + i));
+        const __m128i a    = _mm_loadu_si128((const __m128i*)(aces + i));
+        const __m128i soft = SoftSSE(h, a);
+        const __m128i v    = ValueSSE(h, soft);
+        __m128i hit = _mm_cmpgt_epi8(_mm_set1_epi8(17), v);
+        hit = _mm_or_si128(hit, _mm_and_si128(soft17,
+                  _mm_and_si128(soft, _mm_cmpeq_epi8(v, _mm_set1_epi8(17)))));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_and_si128(hit, _mm_set1_epi8(1)));
+    }
+    return i;
+}
+
+BJ_SSE41 static int DealerScoresSSE(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                                    std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i h  = _mm_loadu_si128((const __m128i*)(hard + i));
+        const __m128i a  = _mm_loadu_si128((const __m128i*)(aces + i));
+        const __m128i c  = _mm_loadu_si128((const __m128i*)(cards + i));
+        const __m128i v  = ValueSSE(h, SoftSSE(h, a));
+        const __m128i bj = _mm_and_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(2)),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8(21)));
+        __m128i s = _mm_blendv_epi8(_mm_set1_epi8(1), v, _mm_cmpgt_epi8(_mm_set1_epi8(22), v));
+        s = _mm_blendv_epi8(s, _mm_set1_epi8(22), bj);
+        _mm_storeu_si128((__m128i*)(out + i), s);
+    }
+    return i;
+}
+
+BJ_SSE41 static int ClassifySSE(const std::uint8_t* hard, const std::uint8_t* aces,
+                                const std::uint8_t* flags, const std::uint8_t* dealer,
+                                std::uint8_t* out, int n)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i h  = _mm_loadu_si128((const __m128i*)(hard + i));
+        const __m128i a  = _mm_loadu_si128((const __m128i*)(aces + i));
+        const __m128i f  = _mm_loadu_si128((const __m128i*)(flags + i));
+        const __m128i d  = _mm_loadu_si128((const __m128i*)(dealer + i));
+        const __m128i v  = ValueSSE(h, SoftSSE(h, a));
+        const __m128i nat  = _mm_cmpeq_epi8(_mm_and_si128(f, one), one);
+        const __m128i surr = _mm_cmpeq_epi8(_mm_and_si128(f, two), two);
+
+        __m128i ps = _mm_blendv_epi8(_mm_setzero_si128(), v, _mm_cmpgt_epi8(_mm_set1_epi8(22), v));
+        ps = _mm_blendv_epi8(ps, _mm_set1_epi8(22), nat);
+
+        const __m128i gt = _mm_cmpgt_epi8(ps, d);
+        const __m128i lt = _mm_cmpgt_epi8(d, ps);
+
+        // 1 - lt + gt + (gt & natural); the compares are -1 where true
+        __m128i cls = _mm_add_epi8(one, _mm_sub_epi8(lt, gt));
+        cls = _mm_sub_epi8(cls, _mm_and_si128(gt, nat));
+        cls = _mm_blendv_epi8(cls, _mm_set1_epi8(BJClassSurrender), surr);
+        _mm_storeu_si128((__m128i*)(out + i), cls);
+    }
+    return i;
+}
+
+// ---------------- AVX2 KERNELS (32 HANDS) ----------------
+
+#define BJ_AVX2 __attribute__((target("avx2")))
+
+BJ_AVX2 static inline __m256i SoftAVX(__m256i h, __m256i a)
+{
+    return _mm256_andnot_si256(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()),
+                               _mm256_cmpgt_epi8(_mm256_set1_epi8(12), h));
+}
+
+BJ_AVX2 static inline __m256i ValueAVX(__m256i h, __m256i soft)
+{
+    return _mm256_add_epi8(h, _mm256_and_si256(soft, _mm256_set1_epi8(10)));
+}
+
+BJ_AVX2 static int AddCardsAVX(std::uint8_t* hard, std::uint8_t* aces, std::uint8_t* cards,
+                               const std::uint8_t* points, int n)
+{
+    const __m256i one = _mm256_set1_epi8(1);
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i p = _mm256_loadu_si256((const __m256i*)(points + i));
+        __m256i h = _mm256_loadu_si256((const __m256i*)(hard + i));
+        __m256i a = _mm256_loadu_si256((const __m256i*)(aces + i));
+        __m256i c = _mm256_loadu_si256((const __m256i*)(cards + i));
+        h = _mm256_add_epi8(h, p);
+        a = _mm256_sub_epi8(a, _mm256_cmpeq_epi8(p, one));
+        c = _mm256_add_epi8(c, _mm256_andnot_si256(_mm256_cmpeq_epi8(p, _mm256_setzero_si256()), one));
+        _mm256_storeu_si256((__m256i*)(hard + i), h);
+        _mm256_storeu_si256((__m256i*)(aces + i), a);
+        _mm256_storeu_si256((__m256i*)(cards + i), c);
+    }
+    return i;
+}
+
+BJ_AVX2 static int ValuesAVX(const std::uint8_t* hard, const std::uint8_t* aces,
+                             std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i h = _mm256_loadu_si256((const __m256i*)(hard + i));
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(aces + i));
+        _mm256_storeu_si256((__m256i*)(out + i), ValueAVX(h, SoftAVX(h, a)));
+    }
+    return i;
+}
+
+BJ_AVX2 static int StatusAVX(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                             std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i h    = _mm256_loadu_si256((const __m256i*)(hard + i));
+        const __m256i a    = _mm256_loadu_si256((const __m256i*)(aces + i));
+        const __m256i c    = _mm256_loadu_si256((const __m256i*)(cards + i));
+        const __m256i soft = SoftAVX(h, a);
+        const __m256i v    = ValueAVX(h, soft);
+        const __m256i bust = _mm256_cmpgt_epi8(h, _mm256_set1_epi8(21));
+        const __m256i bj   = _mm256_and_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(2)),
+                                              _mm256_cmpeq_epi8(v, _mm256_set1_epi8(21)));
+        __m256i s = _mm256_and_si256(soft, _mm256_set1_epi8(BJBatchSoft));
+        s = _mm256_or_si256(s, _mm256_and_si256(bust, _mm256_set1_epi8(BJBatchBust)));
+        s = _mm256_or_si256(s, _mm256_and_si256(bj,   _mm256_set1_epi8(BJBatchBlackjack)));
+        _mm256_storeu_si256((__m256i*)(out + i), s);
+    }
+    return i;
+}
+
+BJ_AVX2 static int DealerMustHitAVX(const std::uint8_t* hard, const std::uint8_t* aces, bool h17,
+                                    std::uint8_t* out, int n)
+{
+    const __m256i soft17 = h17 ? _mm256_set1_epi8(-1) : _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i h    = _mm256_loadu_si256((const __m256i*)(hard + i));
+        const __m256i a    = _mm256_loadu_si256((const __m256i*)(aces + i));
+        const __m256i soft = SoftAVX(h, a);
+        const __m256i v    = ValueAVX(h, soft);
+        __m256i hit = _mm256_cmpgt_epi8(_mm256_set1_epi8(17), v);
+        hit = _mm256_or_si256(hit, _mm256_and_si256(soft17,
+                  _mm256_and_si256(soft, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(17)))));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_and_si256(hit, _mm256_set1_epi8(1)));
+    }
+    return i;
+}
+
+BJ_AVX2 static int DealerScoresAVX(const std::uint8_t* hard, const std::uint8_t* aces, const std::uint8_t* cards,
+                                   std::uint8_t* out, int n)
+{
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i h  = _mm256_loadu_si256((const __m256i*)(hard + i));
+        const __m256i a  = _mm256_loadu_si256((const __m256i*)(aces + i));
+        const __m256i c  = _mm256_loadu_si256((const __m256i*)(cards + i));
+        const __m256i v  = ValueAVX(h, SoftAVX(h, a));
+        const __m256i bj = _mm256_and_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(2)),
+                                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(21)));
+        __m256i s = _mm256_blendv_epi8(_mm256_set1_epi8(1), v,
+                                       _mm256_cmpgt_epi8(_mm256_set1_epi8(22), v));
+        s = _mm256_blendv_epi8(s, _mm256_set1_epi8(22), bj);
+        _mm256_storeu_si256((__m256i*)(out + i), s);
+    }
+    return i;
+}
+
+BJ_AVX2 static int ClassifyAVX(const std::uint8_t* hard, const std::uint8_t* aces,
+                               const std::uint8_t* flags, const std::uint8_t* dealer,
+                               std::uint8_t* out, int n)
+{
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i h  = _mm256_loadu_si256((const __m256i*)(hard + i));
+        const __m256i a  = _mm256_loadu_si256((const __m256i*)(aces + i));
+        const __m256i f  = _mm256_loadu_si256((const __m256i*)(flags + i));
+        const __m256i d  = _mm256_loadu_si256((const __m256i*)(dealer + i));
+        const __m256i v  = ValueAVX(h, SoftAVX(h, a));
+        const __m256i nat  = _mm256_cmpeq_epi8(_mm256_and_si256(f, one), one);
+        const __m256i surr = _mm256_cmpeq_epi8(_mm256_and_si256(f, two), two);
+
+        __m256i ps = _mm256_blendv_epi8(_mm256_setzero_si256(), v,
+                                        _mm256_cmpgt_epi8(_mm256_set1_epi8(22), v));
+        ps = _mm256_blendv_epi8(ps, _mm256_set1_epi8(22), nat);
+
+        const __m256i gt = _mm256_cmpgt_epi8(ps, d);
+        const __m256i lt = _mm256_cmpgt_epi8(d, ps);
+
+        __m256i cls = _mm256_add_epi8(one, _mm256_sub_epi8(lt, gt));
+        cls = _mm256_sub_epi8(cls, _mm256_and_si256(gt, nat));
+        cls = _mm256_blendv_epi8(cls, _mm256_set1_epi8(BJClassSurrender), surr);
+        _mm256_storeu_si256((__m256i*)(out + i), cls);
+    }
+    return i;
+}
+
+#endif // BJ_SIMD_X86
+
+// ---------------- HAND BATCH ----------------
+
+// Runs the kernel for the batch's level over whole vectors, then the scalar
+// kernel over the hands left over.
+#ifdef BJ_SIMD_X86
+#define BJ_DISPATCH(name, ...)                                                  \
+    int done = 0;                                                               \
+    if (level == BJSimdLevel::AVX2)       done = name##AVX(__VA_ARGS__, count); \
+    else if (level == BJSimdLevel::SSE41) done = name##SSE(__VA_ARGS__, count); \
+    name##Scalar(__VA_ARGS__, done, count)
+#else
+#define BJ_DISPATCH(name, ...) name##Scalar(__VA_ARGS__, 0, count)
+#endif
+
+BJHandBatch::BJHandBatch(int n, BJSimdLevel simd)
+    : count(0), level(BJSimdLevel::Scalar)
+{
+    setLevel(simd);
+    resize(n);
+}
+
+void BJHandBatch::resize(int n)
+{
+    count = n;
+    hard.assign(n, 0);
+    aces.assign(n, 0);
+    cards.assign(n, 0);
+}
+
+void BJHandBatch::clear()
+{
+    std::fill(hard.begin(),  hard.end(),  0);
+    std::fill(aces.begin(),  aces.end(),  0);
+    std::fill(cards.begin(), cards.end(), 0);
+}
+
+void BJHandBatch::setLevel(BJSimdLevel simd)
+{
+    const BJSimdLevel best = BJBestSimdLevel();
+    level = (int)simd > (int)best ? best : simd;
+}
+
+void BJHandBatch::set(int i, const BJHand& h)
+{
+    hard[i]  = (std::uint8_t)h.getHardTotal();
+    aces[i]  = (std::uint8_t)h.getAceCount();
+    cards[i] = (std::uint8_t)h.size();
+}
+
+int BJHandBatch::value(int i) const
+{
+    return ValueScalar(hard[i], aces[i]);
+}
+
+void BJHandBatch::addCards(const std::uint8_t* points)
+{
+    BJ_DISPATCH(AddCards, hard.data(), aces.data(), cards.data(), points);
+}
+
+void BJHandBatch::values(std::uint8_t* out) const
+{
+    BJ_DISPATCH(Values, hard.data(), aces.data(), out);
+}
+
+void BJHandBatch::status(std::uint8_t* out) const
+{
+    BJ_DISPATCH(Status, hard.data(), aces.data(), cards.data(), out);
+}
+
+void BJHandBatch::dealerMustHit(bool hitSoft17, std::uint8_t* out) const
+{
+    BJ_DISPATCH(DealerMustHit, hard.data(), aces.data(), hitSoft17, out);
+}
+
+void BJHandBatch::dealerScores(std::uint8_t* out) const
+{
+    BJ_DISPATCH(DealerScores, hard.data(), aces.data(), cards.data(), out);
+}
+
+void BJHandBatch::classify(const std::uint8_t* flags, const std::uint8_t* dealerScores,
+                           std::uint8_t* classes) const
+{
+    BJ_DISPATCH(Classify, hard.data(), aces.data(), flags, dealerScores, classes);
+}
+
+void BJPayBatch(const std::uint8_t* classes, const std::int32_t* bets, int n,
+                const BJPayoutTable& table, BJSettleResult* results)
+{
+    for (int i = 0; i < n; ++i) {
+        results[i].payout  = bets[i] * table.returnTenths[classes[i]] / 10;
+        results[i].outcome = table.outcome[classes[i]];
+    }
+}
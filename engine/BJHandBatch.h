@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+#ifndef BJHandBatchH
+#define BJHandBatchH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+#include "BJHand.h"
+#include "BJSettlement.h"
+
+// ---------------- SIMD LEVEL ----------------
+
+// Kernels the batch can run. Wider levels are only compiled for x86 with
+// GCC or Clang (C++Builder's 64-bit compilers included) and only used when
+// the CPU reports them; everything else runs the scalar loops.
+enum class BJSimdLevel : std::uint8_t {
+    Scalar = 0,
+    SSE41,      // 16 hands per instruction
+    AVX2,       // 32 hands per instruction
+    Count
+};
+
+const char* BJSimdLevelName(BJSimdLevel level);
+
+// Best level this build and CPU support.
+BJSimdLevel BJBestSimdLevel();
+
+// ---------------- HAND BATCH ----------------
+
+// Status bits from BJHandBatch::status().
+enum BJBatchStatus : std::uint8_t {
+    BJBatchSoft      = 1,
+    BJBatchBust      = 2,
+    BJBatchBlackjack = 4     // two cards totalling 21
+};
+
+// Many independent hands kept as struct-of-arrays: one byte each of hard
+// total (aces as 1), ace count and card count, the same running totals
+// BJHand keeps. Every bulk operation walks the arrays a vector at a time,
+// so one instruction updates 16 or 32 hands, with a scalar tail.
+//
+// Hand i of a batch is usually seat or table i; per-hand inputs and outputs
+// are arrays of size() entries in the same order.
+class BJHandBatch {
+private:
+    int                       count;
+    BJSimdLevel               level;
+    std::vector<std::uint8_t> hard;
+    std::vector<std::uint8_t> aces;
+    std::vector<std::uint8_t> cards;
+
+public:
+    explicit BJHandBatch(int n = 0, BJSimdLevel simd = BJBestSimdLevel());
+
+    int  size() const noexcept { return count; }
+    void resize(int n);
+    void clear();                  // every hand back to no cards
+
+    BJSimdLevel getLevel() const noexcept { return level; }
+    void        setLevel(BJSimdLevel simd);   // clamped to BJBestSimdLevel()
+
+    // Single-hand access, for loading and checking.
+    void set(int i, const BJHand& h);
+    int  getHardTotal(int i) const { return hard[i]; }
+    int  getAceCount(int i)  const { return aces[i]; }
+    int  getCardCount(int i) const { return cards[i]; }
+    int  value(int i) const;
+
+    // Adds one card to each hand; points[i] is the card's points (1 = ace
+    // .. 10), 0 leaves hand i as it is.
+    void addCards(const std::uint8_t* points);
+
+    // Best totals, as BJHand::value().
+    void values(std::uint8_t* out) const;
+
+    // BJBatchStatus bits per hand.
+    void status(std::uint8_t* out) const;
+
+    // 1 where a dealer holding the hand must draw, else 0.
+    void dealerMustHit(bool hitSoft17, std::uint8_t* out) const;
+
+    // BJDealerScore of each hand, a two-card 21 counting as the natural.
+    void dealerScores(std::uint8_t* out) const;
+
+    // BJSettleClass of each hand against dealerScores[i]; flags[i] are the
+    // hand's BJSettleFlags (natural, surrendered) as for BJSettleRecord.
+    void classify(const std::uint8_t* flags, const std::uint8_t* dealerScores,
+                  std::uint8_t* classes) const;
+};
+
+// Payouts and outcomes for classified hands, as BJSettleHands.
+void BJPayBatch(const std::uint8_t* classes, const std::int32_t* bets, int n,
+                const BJPayoutTable& table, BJSettleResult* results);
+
+//---------------------------------------------------------------------------
+#endif
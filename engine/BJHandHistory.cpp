@@ -0,0 +1,461 @@
+//---------------------------------------------------------------------------
+#include "BJHandHistory.h"
+
+#include <cstring>
+#include <ostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX                // keep std::min / std::max usable
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+//---------------------------------------------------------------------------
+
+static const char BJHistoryFileMagic[4]  = { 'B', 'J', 'H', 'H' };
+static const char BJHistoryBlockMagic[4] = { 'B', 'J', 'H', 'B' };
+static const char BJHistoryIndexMagic[4] = { 'B', 'J', 'H', 'I' };
+
+static const std::size_t BJHistoryFileHeader  = 8;
+static const std::size_t BJHistoryIndexEntry  = 28;
+static const std::size_t BJHistoryFooter      = 16;
+static const int         BJHistoryMaxCards    = 0x0F + 0xFF;   // nibble plus extra byte
+
+static void PutLE(std::uint8_t* p, std::uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        p[i] = (std::uint8_t)(v >> (8 * i));
+}
+
+static std::uint64_t GetLE(const std::uint8_t* p, int bytes)
+{
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v |= (std::uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+// ---------------- CURSOR ----------------
+
+BJHistoryCursor::BJHistoryCursor(const std::uint8_t* payload, std::size_t bytes, std::uint64_t firstRound)
+    : pos(payload), end(payload + bytes), round(firstRound), seatsLeft(0)
+{
+    for (int& b : lastBet) b = 0;
+}
+
+std::uint8_t BJHistoryCursor::getByte()
+{
+    if (pos == end)
+        throw std::runtime_error("Hand history record runs past its block");
+    return *pos++;
+}
+
+std::uint64_t BJHistoryCursor::getVarint()
+{
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const std::uint8_t b = getByte();
+        v |= (std::uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return v;
+    }
+    throw std::runtime_error("Bad varint in hand history");
+}
+
+std::int64_t BJHistoryCursor::getZigzag()
+{
+    const std::uint64_t z = getVarint();
+    return (std::int64_t)(z >> 1) ^ -(std::int64_t)(z & 1);
+}
+
+int BJHistoryCursor::getCardCount(std::uint8_t nibble)
+{
+    return nibble == 0x0F ? 0x0F + getByte() : nibble;
+}
+
+const BJCard* BJHistoryCursor::getCards(int n)
+{
+    if (end - pos < n)
+        throw std::runtime_error("Hand history record runs past its block");
+    const BJCard* cards = reinterpret_cast<const BJCard*>(pos);
+    pos += n;
+    return cards;
+}
+
+bool BJHistoryCursor::nextRound(BJHistoryRound& out)
+{
+    if (seatsLeft)
+        skipSeats();
+    if (pos == end)
+        return false;
+
+    round += getVarint();
+    out.round = round;
+
+    const std::uint8_t head = getByte();
+    out.seatCount = head >> 4;
+    if (out.seatCount > BJHistoryMaxSeats)
+        throw std::runtime_error("Bad seat count in hand history");
+    out.dealerCardCount = getCardCount(head & 0x0F);
+    out.trueCount10     = (int)getZigzag();
+    out.dealerCards = getCards(out.dealerCardCount);
+
+    seatsLeft = out.seatCount;
+    return true;
+}
+
+void BJHistoryCursor::readSeats(BJHistoryRound& out)
+{
+    for (int s = 0; s < out.seatCount && seatsLeft; ++s, --seatsLeft) {
+        BJHistorySeat& seat = out.seats[s];
+
+        const std::uint8_t sb = getByte();
+        seat.seat      = sb & 7;
+        seat.handCount = (sb & 8) ? 2 : 1;
+        if (seat.seat >= BJHistoryMaxSeats)
+            throw std::runtime_error("Bad seat in hand history");
+
+        seat.bet = lastBet[seat.seat] + (int)getZigzag();
+        lastBet[seat.seat] = seat.bet;
+        seat.net = (int)getZigzag();
+
+        for (int h = 0; h < seat.handCount; ++h) {
+            BJHistoryHand& hand = seat.hands[h];
+            const std::uint8_t hb = getByte();
+            hand.cardCount   = getCardCount(hb & 0x0F);
+            hand.doubled     = (hb & 0x10) != 0;
+            hand.surrendered = (hb & 0x20) != 0;
+            hand.outcome     = (int)(hb >> 6) - 1;
+            hand.cards       = getCards(hand.cardCount);
+        }
+    }
+}
+
+// Same walk as readSeats() with nothing stored but the bet deltas, which
+// later rounds of the block depend on.
+void BJHistoryCursor::skipSeats()
+{
+    for (; seatsLeft; --seatsLeft) {
+        const std::uint8_t sb = getByte();
+        const int seat = sb & 7;
+        if (seat >= BJHistoryMaxSeats)
+            throw std::runtime_error("Bad seat in hand history");
+
+        lastBet[seat] += (int)getZigzag();
+        getVarint();
+
+        for (int h = (sb & 8) ? 2 : 1; h > 0; --h)
+            getCards(getCardCount(getByte() & 0x0F));
+    }
+}
+
+// ---------------- WRITER ----------------
+
+BJHandHistoryWriter::BJHandHistoryWriter(std::ostream& os, const BJRuntimeRules& rules,
+                                         std::size_t block_bytes)
+    : out(os),
+      blockBytes(block_bytes > 0 ? block_bytes : BJHistoryBlockBytes),
+      offset(0),
+      nextRound(0),
+      closed(false),
+      blockFirst(0),
+      blockLast(0),
+      blockRounds(0),
+      blockCountMin(0),
+      blockCountMax(0),
+      seatCount(0),
+      count10(0)
+{
+    for (int& b : lastBet) b = 0;
+    block.reserve(blockBytes + 256);
+
+    std::uint8_t header[BJHistoryFileHeader];
+    std::memcpy(header, BJHistoryFileMagic, 4);
+    PutLE(header + 4, BJHistoryVersion, 2);
+    PutLE(header + 6, rules.dealerPeek() ? BJHistoryDealerPeeks : 0, 2);
+    write(header, sizeof header);
+}
+
+BJHandHistoryWriter::~BJHandHistoryWriter()
+{
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void BJHandHistoryWriter::write(const void* data, std::size_t n)
+{
+    out.write((const char*)data, (std::streamsize)n);
+    if (!out)
+        throw std::runtime_error("Could not write hand history");
+    offset += n;
+}
+
+void BJHandHistoryWriter::putHand(const BJHistoryHand& h)
+{
+    std::uint8_t b = (std::uint8_t)std::min(h.cardCount, 0x0F);
+    if (h.doubled)     b |= 0x10;
+    if (h.surrendered) b |= 0x20;
+    b |= (std::uint8_t)((h.outcome + 1) << 6);
+    block.push_back(b);
+    if (h.cardCount >= 0x0F)
+        block.push_back((std::uint8_t)(h.cardCount - 0x0F));
+
+    for (int i = 0; i < h.cardCount; ++i)
+        block.push_back(h.cards[i].getCode());
+}
+
+// Everything the record's fields have room for, checked before a byte of
+// the round is written.
+static bool Fits(const BJHistoryRound& r)
+{
+    if (r.seatCount < 0 || r.seatCount > BJHistoryMaxSeats ||
+        r.dealerCardCount < 0 || r.dealerCardCount > BJHistoryMaxCards)
+        return false;
+
+    for (int s = 0; s < r.seatCount; ++s) {
+        const BJHistorySeat& seat = r.seats[s];
+        if (seat.seat < 0 || seat.seat >= BJHistoryMaxSeats ||
+            seat.handCount < 1 || seat.handCount > 2)
+            return false;
+        for (int h = 0; h < seat.handCount; ++h) {
+            const BJHistoryHand& hand = seat.hands[h];
+            if (hand.cardCount < 0 || hand.cardCount > BJHistoryMaxCards ||
+                hand.outcome < -1 || hand.outcome > 1)
+                return false;
+        }
+    }
+    return true;
+}
+
+void BJHandHistoryWriter::writeRound(const BJHistoryRound& r)
+{
+    if (closed)
+        throw std::logic_error("Hand history is closed");
+    if (!Fits(r))
+        throw std::invalid_argument("Round does not fit a hand-history record");
+
+    if (blockRounds == 0) {
+        blockFirst    = nextRound;
+        blockLast     = nextRound;
+        blockCountMin = r.trueCount10;
+        blockCountMax = r.trueCount10;
+        for (int& b : lastBet) b = 0;
+    }
+
+    putVarint(nextRound - blockLast);
+    blockLast     = nextRound;
+    blockCountMin = std::min(blockCountMin, r.trueCount10);
+    blockCountMax = std::max(blockCountMax, r.trueCount10);
+
+    block.push_back((std::uint8_t)(std::min(r.dealerCardCount, 0x0F) | r.seatCount << 4));
+    if (r.dealerCardCount >= 0x0F)
+        block.push_back((std::uint8_t)(r.dealerCardCount - 0x0F));
+    putZigzag(r.trueCount10);
+    for (int i = 0; i < r.dealerCardCount; ++i)
+        block.push_back(r.dealerCards[i].getCode());
+
+    for (int s = 0; s < r.seatCount; ++s) {
+        const BJHistorySeat& seat = r.seats[s];
+        block.push_back((std::uint8_t)(seat.seat | (seat.handCount == 2 ? 8 : 0)));
+        putZigzag((std::int64_t)seat.bet - lastBet[seat.seat]);
+        putZigzag(seat.net);
+        lastBet[seat.seat] = seat.bet;
+
+        for (int h = 0; h < seat.handCount; ++h)
+            putHand(seat.hands[h]);
+    }
+
+    ++nextRound;
+    ++blockRounds;
+    if (block.size() >= blockBytes)
+        flushBlock();
+}
+
+void BJHandHistoryWriter::flushBlock()
+{
+    if (blockRounds == 0)
+        return;
+
+    BJHistoryBlockInfo info;
+    info.offset     = offset;
+    info.firstRound = blockFirst;
+    info.rounds     = blockRounds;
+    info.bytes      = (std::uint32_t)block.size();
+    info.countMin   = (std::int16_t)blockCountMin;
+    info.countMax   = (std::int16_t)blockCountMax;
+
+    std::uint8_t header[BJHistoryBlockHeader];
+    std::memcpy(header, BJHistoryBlockMagic, 4);
+    PutLE(header + 4,  info.bytes, 4);
+    PutLE(header + 8,  info.rounds, 4);
+    PutLE(header + 12, info.firstRound, 8);
+    write(header, sizeof header);
+    write(block.data(), block.size());
+
+    index.push_back(info);
+    block.clear();
+    blockRounds = 0;
+}
+
+void BJHandHistoryWriter::close()
+{
+    if (closed)
+        return;
+    closed = true;
+
+    flushBlock();
+
+    const std::uint64_t indexOffset = offset;
+    std::vector<std::uint8_t> buf(index.size() * BJHistoryIndexEntry + BJHistoryFooter);
+    std::uint8_t* p = buf.data();
+    for (const auto& bi : index) {
+        PutLE(p,      bi.offset, 8);
+        PutLE(p + 8,  bi.firstRound, 8);
+        PutLE(p + 16, bi.rounds, 4);
+        PutLE(p + 20, bi.bytes, 4);
+        PutLE(p + 24, (std::uint16_t)bi.countMin, 2);
+        PutLE(p + 26, (std::uint16_t)bi.countMax, 2);
+        p += BJHistoryIndexEntry;
+    }
+    PutLE(p, indexOffset, 8);
+    PutLE(p + 8, index.size(), 4);
+    std::memcpy(p + 12, BJHistoryIndexMagic, 4);
+
+    write(buf.data(), buf.size());
+    out.flush();
+}
+
+// ---------------- READER ----------------
+
+BJHandHistoryFile::BJHandHistoryFile(const std::string& path)
+    : data(nullptr), size(0), mapping(nullptr), rounds(0), flags(0)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open " + path);
+
+    LARGE_INTEGER len;
+    if (!GetFileSizeEx(file, &len) || len.QuadPart == 0) {
+        CloseHandle(file);
+        throw std::runtime_error("Not a hand history: " + path);
+    }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!map)
+        throw std::runtime_error("Cannot map " + path);
+
+    const void* view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(map);
+        throw std::runtime_error("Cannot map " + path);
+    }
+    data    = (const std::uint8_t*)view;
+    size    = (std::size_t)len.QuadPart;
+    mapping = map;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open " + path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Not a hand history: " + path);
+    }
+    void* view = ::mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        throw std::runtime_error("Cannot map " + path);
+    ::madvise(view, (std::size_t)st.st_size, MADV_SEQUENTIAL);
+
+    data = (const std::uint8_t*)view;
+    size = (std::size_t)st.st_size;
+#endif
+
+    try {
+        if (size < BJHistoryFileHeader + BJHistoryFooter ||
+            std::memcmp(data, BJHistoryFileMagic, 4) != 0)
+            throw std::runtime_error("Not a hand history: " + path);
+        if (GetLE(data + 4, 2) != BJHistoryVersion)
+            throw std::runtime_error("Unsupported hand history version in " + path);
+        flags = (std::uint16_t)GetLE(data + 6, 2);
+
+        const std::uint8_t* foot = data + size - BJHistoryFooter;
+        if (std::memcmp(foot + 12, BJHistoryIndexMagic, 4) != 0)
+            throw std::runtime_error("Hand history has no index (not closed?): " + path);
+
+        const std::uint64_t indexOffset = GetLE(foot, 8);
+        const std::uint64_t count       = GetLE(foot + 8, 4);
+        if (indexOffset + count * BJHistoryIndexEntry != size - BJHistoryFooter)
+            throw std::runtime_error("Bad hand history index in " + path);
+
+        blocks.resize((std::size_t)count);
+        const std::uint8_t* p = data + indexOffset;
+        for (auto& bi : blocks) {
+            bi.offset     = GetLE(p, 8);
+            bi.firstRound = GetLE(p + 8, 8);
+            bi.rounds     = (std::uint32_t)GetLE(p + 16, 4);
+            bi.bytes      = (std::uint32_t)GetLE(p + 20, 4);
+            bi.countMin   = (std::int16_t)GetLE(p + 24, 2);
+            bi.countMax   = (std::int16_t)GetLE(p + 26, 2);
+            p += BJHistoryIndexEntry;
+
+            if (bi.offset + BJHistoryBlockHeader + bi.bytes > indexOffset ||
+                std::memcmp(data + bi.offset, BJHistoryBlockMagic, 4) != 0)
+                throw std::runtime_error("Bad hand history block in " + path);
+            rounds += bi.rounds;
+        }
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+BJHandHistoryFile::~BJHandHistoryFile()
+{
+    unmap();
+}
+
+void BJHandHistoryFile::prefetch(int first, int last) const noexcept
+{
+    if (first < 0 || last >= getBlockCount() || first > last)
+        return;
+    const std::uint64_t from = blocks[first].offset;
+    const std::uint64_t to   = blocks[last].offset + BJHistoryBlockHeader + blocks[last].bytes;
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = (PVOID)(data + from);
+    range.NumberOfBytes  = (SIZE_T)(to - from);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // madvise wants a page-aligned start
+    const std::uintptr_t page  = (std::uintptr_t)::sysconf(_SC_PAGESIZE);
+    const std::uintptr_t start = (std::uintptr_t)(data + from) & ~(page - 1);
+    ::madvise((void*)start, (std::size_t)((std::uintptr_t)(data + to) - start), MADV_WILLNEED);
+#endif
+}
+
+void BJHandHistoryFile::unmap() noexcept
+{
+    if (!data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)mapping);
+#else
+    ::munmap((void*)data, size);
+#endif
+    data = nullptr;
+}
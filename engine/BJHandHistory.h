@@ -0,0 +1,331 @@
+//---------------------------------------------------------------------------
+#ifndef BJHandHistoryH
+#define BJHandHistoryH
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BJCard.h"
+#include "BJGame.h"
+#include "BJRound.h"
+
+// ---------------- FILE FORMAT ----------------
+
+// Hand-history archive: every round's cards, bets, actions and results,
+// stored as a sequence of independent blocks and an index, so a reader can
+// jump to any block or hand blocks to threads. All integers are little
+// endian; varints are LEB128, zigzag where signed.
+//
+//     file header   "BJHH", u16 version, u16 table flags
+//     blocks        "BJHB", u32 payload bytes, u32 rounds, u64 first round,
+//                   then the rounds' records
+//     index         per block: u64 offset, u64 first round, u32 rounds,
+//                   u32 payload bytes, i16 lowest and i16 highest true
+//                   count in the block (tenths)
+//     footer        u64 index offset, u32 block count, "BJHI"
+//
+// A round record:
+//     varint   round number minus the previous one (the block's first
+//              round for the first record)
+//     byte     dealer card count | seats in the round << 4
+//     [byte]   dealer card count - 15, when the nibble is 15
+//     zigzag   Hi-Lo true count at the deal, in tenths
+//     bytes    dealer cards
+//     per seat
+//       byte   seat | split << 3
+//       zigzag bet minus this seat's previous bet in the block
+//       zigzag chips won or lost in the round
+//       per hand
+//         byte   card count | doubled << 4 | surrendered << 5 | (outcome + 1) << 6
+//         [byte] card count - 15, when the nibble is 15
+//         bytes  cards
+//
+// Cards are BJCard codes, a byte each, so a reader hands them out in place.
+// Hits and stands are not stored: they are the cards. Delta state restarts
+// with every block, which keeps blocks decodable on their own.
+
+constexpr std::uint16_t BJHistoryVersion     = 1;
+
+// Table flags: rules a reader needs to tell what the players saw.
+constexpr std::uint16_t BJHistoryDealerPeeks = 1;   // a dealer natural ends the round unplayed
+constexpr int           BJHistoryMaxSeats    = 7;
+constexpr std::size_t   BJHistoryBlockBytes  = 64 * 1024;   // payload at which a block closes
+constexpr std::size_t   BJHistoryBlockHeader = 20;
+
+struct BJHistoryBlockInfo {
+    std::uint64_t offset;           // of the block header
+    std::uint64_t firstRound;
+    std::uint32_t rounds;
+    std::uint32_t bytes;            // payload, header excluded
+    std::int16_t  countMin;         // true count range of the block's rounds,
+    std::int16_t  countMax;         // in tenths
+};
+
+// ---------------- ROUND VIEW ----------------
+
+// One decoded round. Card pointers point into the mapped file (or the
+// block being decoded) and stay valid as long as it does.
+struct BJHistoryHand {
+    const BJCard* cards;
+    int           cardCount;
+    int           outcome;          // -1 / 0 / +1 as BJPlayer reports it
+    bool          doubled;
+    bool          surrendered;
+};
+
+struct BJHistorySeat {
+    int           seat;
+    int           bet;              // before any double or split
+    int           net;              // chips won (+) or lost (-)
+    int           handCount;        // 2 after a split
+    BJHistoryHand hands[2];
+};
+
+struct BJHistoryRound {
+    std::uint64_t round;
+    int           trueCount10;      // Hi-Lo true count at the deal, tenths
+    const BJCard* dealerCards;
+    int           dealerCardCount;
+    int           seatCount;
+    BJHistorySeat seats[BJHistoryMaxSeats];
+};
+
+// Walks one block's records front to back, decoding into a caller-owned
+// BJHistoryRound without allocating. Throws std::runtime_error on a record
+// that runs past the block.
+//
+// nextRound() decodes only the round-level fields (number, count, dealer);
+// the seats then have to be read with readSeats() or passed over with
+// skipSeats(), so a scan can reject a round before decoding its seats.
+class BJHistoryCursor {
+private:
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+    std::uint64_t       round;
+    int                 seatsLeft;
+    int                 lastBet[BJHistoryMaxSeats];
+
+    std::uint8_t  getByte();
+    std::uint64_t getVarint();
+    std::int64_t  getZigzag();
+    int           getCardCount(std::uint8_t nibble);
+    const BJCard* getCards(int n);
+
+public:
+    BJHistoryCursor(const std::uint8_t* payload, std::size_t bytes, std::uint64_t firstRound);
+
+    bool nextRound(BJHistoryRound& out);
+    void readSeats(BJHistoryRound& out);
+    void skipSeats();
+
+    bool next(BJHistoryRound& out) {
+        if (!nextRound(out))
+            return false;
+        readSeats(out);
+        return true;
+    }
+};
+
+// ---------------- WRITER ----------------
+
+// Records rounds as they are played and writes them out a block at a time.
+// It follows a round through the same calls as BJRoundLog (beginRound after
+// the bets, action before each call on a hand, endRound after settlement),
+// so BJPlayRecordedRound drives either.
+class BJHandHistoryWriter {
+private:
+    std::ostream&                   out;
+    std::size_t                     blockBytes;
+    std::uint64_t                   offset;
+    std::uint64_t                   nextRound;
+    bool                            closed;
+
+    std::vector<std::uint8_t>       block;
+    std::uint64_t                   blockFirst;
+    std::uint64_t                   blockLast;
+    std::uint32_t                   blockRounds;
+    int                             blockCountMin;
+    int                             blockCountMax;
+    int                             lastBet[BJHistoryMaxSeats];
+    std::vector<BJHistoryBlockInfo> index;
+
+    // the round in progress
+    int           seatCount;
+    int           count10;
+    std::uint8_t  seats[BJHistoryMaxSeats];
+    int           bets[BJHistoryMaxSeats];
+    int           chipsBefore[BJHistoryMaxSeats];
+    std::uint8_t  doubled[BJHistoryMaxSeats];      // bit per hand
+
+    void putVarint(std::uint64_t v) {
+        while (v >= 0x80) {
+            block.push_back((std::uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        block.push_back((std::uint8_t)v);
+    }
+    void putZigzag(std::int64_t v) {
+        putVarint(((std::uint64_t)v << 1) ^ (std::uint64_t)(v >> 63));
+    }
+    void putHand(const BJHistoryHand& h);
+
+    void write(const void* data, std::size_t n);
+    void flushBlock();
+
+public:
+    // Writes the file header, with the table's rules, straight away.
+    // blockBytes is the payload size at which a block is closed.
+    BJHandHistoryWriter(std::ostream& os, const BJRuntimeRules& rules,
+                        std::size_t block_bytes = BJHistoryBlockBytes);
+    ~BJHandHistoryWriter();        // close(), errors swallowed
+
+    BJHandHistoryWriter(const BJHandHistoryWriter&)            = delete;
+    BJHandHistoryWriter& operator=(const BJHandHistoryWriter&) = delete;
+
+    // Number the next round gets; rounds count up from there. Numbers may
+    // skip (several tables sharing one numbering) but never go back.
+    void setNextRound(std::uint64_t n) { nextRound = n; }
+
+    template <class Game>
+    void beginRound(const Game& g);
+
+    template <class Game>
+    void action(const Game& g, BJAction a) {
+        if (a != BJAction::Double)
+            return;
+        for (int s = 0; s < seatCount; ++s)
+            if (seats[s] == g.getCurrentPlayerIndex())
+                doubled[s] |= (std::uint8_t)(1u << g.getCurrentHandIndex());
+    }
+
+    template <class Game>
+    void endRound(const Game& g, bool dealerPlayed);
+
+    // Appends a round assembled elsewhere (the event log's sink); r.round
+    // is ignored, the round takes the next number like any other. Throws
+    // std::invalid_argument, writing nothing, for a seat, hand count, card
+    // count or outcome the record cannot hold.
+    void writeRound(const BJHistoryRound& r);
+
+    std::uint64_t getRoundCount() const noexcept { return nextRound; }
+    std::uint64_t getBytesWritten() const noexcept { return offset; }
+
+    // Flushes the open block and writes the index and footer. Further
+    // rounds are refused.
+    void close();
+};
+
+template <class Game>
+void BJHandHistoryWriter::beginRound(const Game& g)
+{
+    // the count the round is dealt at: a due reshuffle restarts it
+    const auto& shoe = g.GetShoe();
+    const double tc  = shoe.needsReshuffle() ? 0.0 : shoe.trueCount();
+    count10 = (int)std::lround(std::min(std::max(tc * 10.0, -32000.0), 32000.0));
+
+    seatCount = 0;
+    for (int i = 0; i < g.getPlayerCount() && i < BJHistoryMaxSeats; ++i) {
+        const BJPlayer& p = g.GetPlayer(i);
+        if (p.isBankrupt() || p.getBet() <= 0)
+            continue;
+        seats[seatCount]       = (std::uint8_t)i;
+        bets[seatCount]        = p.getBet();
+        chipsBefore[seatCount] = p.getChips() + p.getBet();
+        doubled[seatCount]     = 0;
+        ++seatCount;
+    }
+}
+
+template <class Game>
+void BJHandHistoryWriter::endRound(const Game& g, bool)
+{
+    BJHistoryRound r;
+    r.round       = nextRound;
+    r.trueCount10 = count10;
+
+    const BJHand& dh = g.GetDealer().GetHand();
+    r.dealerCards     = dh.GetCards().data();
+    r.dealerCardCount = (int)dh.size();
+
+    r.seatCount = seatCount;
+    for (int s = 0; s < seatCount; ++s) {
+        const BJPlayer& p    = g.GetPlayer(seats[s]);
+        BJHistorySeat&  seat = r.seats[s];
+        seat.seat      = seats[s];
+        seat.bet       = bets[s];
+        seat.net       = p.getChips() - chipsBefore[s];
+        seat.handCount = p.hasSplitHand() ? 2 : 1;
+
+        for (int h = 0; h < seat.handCount; ++h) {
+            const BJHand&  hand = h == 0 ? p.GetHand() : p.GetSplitHand();
+            BJHistoryHand& out  = seat.hands[h];
+            out.cards       = hand.GetCards().data();
+            out.cardCount   = (int)hand.size();
+            out.outcome     = h == 0 ? p.getRoundOutcomeMain() : p.getRoundOutcomeSplit();
+            out.doubled     = (doubled[s] >> h) & 1;
+            out.surrendered = hand.getStatus() == BJHandStatus::Surrendered;
+        }
+    }
+    writeRound(r);
+}
+
+// ---------------- READER ----------------
+
+// A hand-history file mapped read-only into memory. Blocks are decoded
+// straight from the mapping; nothing is copied. Throws std::runtime_error
+// if the file cannot be mapped or is not a complete archive (a writer that
+// never closed leaves no footer).
+class BJHandHistoryFile {
+private:
+    const std::uint8_t*             data;
+    std::size_t                     size;
+    void*                           mapping;      // platform handle
+    std::vector<BJHistoryBlockInfo> blocks;
+    std::uint64_t                   rounds;
+    std::uint16_t                   flags;
+
+    void unmap() noexcept;
+
+public:
+    explicit BJHandHistoryFile(const std::string& path);
+    ~BJHandHistoryFile();
+
+    BJHandHistoryFile(const BJHandHistoryFile&)            = delete;
+    BJHandHistoryFile& operator=(const BJHandHistoryFile&) = delete;
+
+    std::size_t   getSize()       const noexcept { return size; }
+    std::uint64_t getRoundCount() const noexcept { return rounds; }
+    bool          dealerPeeks()   const noexcept { return (flags & BJHistoryDealerPeeks) != 0; }
+    int           getBlockCount() const noexcept { return (int)blocks.size(); }
+
+    const BJHistoryBlockInfo& getBlock(int b) const { return blocks[b]; }
+
+    // Asks the OS to start reading blocks [first, last] in; a hint, which
+    // returns at once and may do nothing.
+    void prefetch(int first, int last) const noexcept;
+
+    BJHistoryCursor cursor(int b) const {
+        const BJHistoryBlockInfo& bi = blocks[b];
+        return BJHistoryCursor(data + bi.offset + BJHistoryBlockHeader, bi.bytes, bi.firstRound);
+    }
+
+    // f(const BJHistoryRound&) for every round, in order.
+    template <class F>
+    void forEach(F f) const {
+        BJHistoryRound r;
+        for (int b = 0; b < getBlockCount(); ++b) {
+            BJHistoryCursor c = cursor(b);
+            while (c.next(r))
+                f(r);
+        }
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,277 @@
+//---------------------------------------------------------------------------
+#include "BJHistoryQuery.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+//---------------------------------------------------------------------------
+
+// ---------------- GROUPS ----------------
+
+int BJHistoryGroupCount(BJHistoryGroup g)
+{
+    switch (g) {
+        case BJHistoryGroup::Upcard:    return 11;
+        case BJHistoryGroup::Total:     return 22;
+        case BJHistoryGroup::Action:    return BJFirstActionSlots;
+        case BJHistoryGroup::TrueCount: return BJHistoryCountGroups;
+        case BJHistoryGroup::Seat:      return BJHistoryMaxSeats;
+        default:                        return 1;
+    }
+}
+
+const char* BJHistoryGroupName(BJHistoryGroup g)
+{
+    switch (g) {
+        case BJHistoryGroup::Upcard:    return "upcard";
+        case BJHistoryGroup::Total:     return "total";
+        case BJHistoryGroup::Action:    return "action";
+        case BJHistoryGroup::TrueCount: return "count";
+        case BJHistoryGroup::Seat:      return "seat";
+        default:                        return "all";
+    }
+}
+
+std::string BJHistoryGroupLabel(BJHistoryGroup g, int group)
+{
+    switch (g) {
+        case BJHistoryGroup::Upcard:
+            return group == 1 ? "A" : std::to_string(group);
+        case BJHistoryGroup::Action:
+            return group == BJNoAction ? "none" : BJActionName((BJAction)group);
+        case BJHistoryGroup::TrueCount: {
+            const int tc = group - BJHistoryCountClamp;
+            const std::string s = tc > 0 ? "+" + std::to_string(tc) : std::to_string(tc);
+            if (tc == BJHistoryCountClamp)  return ">=" + s;
+            if (tc == -BJHistoryCountClamp) return "<=" + s;
+            return s;
+        }
+        case BJHistoryGroup::Seat:
+            return std::to_string(group + 1);
+        case BJHistoryGroup::Total:
+            return std::to_string(group);
+        default:
+            return "all";
+    }
+}
+
+// ---------------- TOTALS ----------------
+
+void BJHistoryTotals::merge(const BJHistoryTotals& o)
+{
+    seatRounds += o.seatRounds;
+    hands      += o.hands;
+    wins       += o.wins;
+    pushes     += o.pushes;
+    losses     += o.losses;
+    net        += o.net;
+    wagered    += o.wagered;
+    perBet.merge(o.perBet);
+}
+
+BJHistoryTotals BJHistoryResult::total() const
+{
+    BJHistoryTotals t;
+    for (const auto& g : groups)
+        t.merge(g);
+    return t;
+}
+
+// ---------------- SEAT DECODE ----------------
+
+// What the filters and groups look at, derived from a seat's record.
+struct BJHistorySeatKey {
+    int  total;
+    bool soft;
+    bool pair;
+    int  action;
+};
+
+// dealerNatural: the round ended on the dealer's peek, before anyone acted.
+static BJHistorySeatKey SeatKey(const BJHistorySeat& s, bool dealerNatural)
+{
+    const BJHistoryHand& h0 = s.hands[0];
+    const BJCard c0 = h0.cards[0];
+    const BJCard c1 = s.handCount == 2 ? s.hands[1].cards[0] : h0.cards[1];
+
+    BJHistorySeatKey k;
+    const int p0   = c0.getPoints();
+    const int p1   = c1.getPoints();
+    const int hard = p0 + p1;
+    k.soft  = (p0 == 1 || p1 == 1) && hard + 10 <= 21;
+    k.total = k.soft ? hard + 10 : hard;
+    k.pair  = p0 == p1;                 // the engine splits any two ten-valued cards
+
+    if (dealerNatural)          k.action = BJNoAction;
+    else if (s.handCount == 2)  k.action = (int)BJAction::Split;
+    else if (h0.surrendered)    k.action = (int)BJAction::Surrender;
+    else if (h0.doubled)        k.action = (int)BJAction::Double;
+    else if (h0.cardCount > 2)  k.action = (int)BJAction::Hit;
+    else if (k.total == 21)     k.action = BJNoAction;
+    else                        k.action = (int)BJAction::Stand;
+    return k;
+}
+
+static bool SeatMatches(const BJHistoryQuery& q, const BJHistorySeat& s, const BJHistorySeatKey& k)
+{
+    const int sign = (s.net > 0) - (s.net < 0);
+    if (q.seat >= 0 && s.seat != q.seat)              return false;
+    if (q.outcome != -2 && sign != q.outcome)         return false;
+    if (k.total < q.totalMin || k.total > q.totalMax) return false;
+    if (q.soft >= 0 && k.soft != (q.soft != 0))       return false;
+    if (q.pair >= 0 && k.pair != (q.pair != 0))       return false;
+    if (q.action >= 0 && k.action != q.action)        return false;
+    return true;
+}
+
+static int GroupOf(BJHistoryGroup g, const BJHistoryRound& r, int upcard,
+                   const BJHistorySeat& s, const BJHistorySeatKey& k)
+{
+    switch (g) {
+        case BJHistoryGroup::Upcard:    return upcard;
+        case BJHistoryGroup::Total:     return k.total;
+        case BJHistoryGroup::Action:    return k.action;
+        case BJHistoryGroup::Seat:      return s.seat;
+        case BJHistoryGroup::TrueCount: {
+            int tc = r.trueCount10 / 10;            // toward zero
+            if (tc < -BJHistoryCountClamp) tc = -BJHistoryCountClamp;
+            if (tc >  BJHistoryCountClamp) tc =  BJHistoryCountClamp;
+            return tc + BJHistoryCountClamp;
+        }
+        default:                        return 0;
+    }
+}
+
+// ---------------- RUNNER ----------------
+
+// A contiguous stretch of one file's blocks, all of which the index let
+// through.
+struct BJHistoryRun {
+    int           file;
+    int           first;
+    int           last;
+    std::uint64_t bytes;
+};
+
+static void ScanRun(const BJHandHistoryFile& file, const BJHistoryRun& run, const BJHistoryQuery& q,
+                    BJHistoryGroup group, std::vector<BJHistoryTotals>& out, std::uint64_t& rounds)
+{
+    const bool countFilter = q.filtersCount();
+    const bool peeks       = file.dealerPeeks();
+    BJHistoryRound r;
+
+    file.prefetch(run.first, run.last);
+    for (int b = run.first; b <= run.last; ++b) {
+        BJHistoryCursor c = file.cursor(b);
+        while (c.nextRound(r)) {
+            ++rounds;
+            if (countFilter && (r.trueCount10 < q.countMin || r.trueCount10 > q.countMax))
+                continue;
+            const int upcard = r.dealerCardCount ? r.dealerCards[0].getPoints() : 0;
+            if (q.upcard && upcard != q.upcard)
+                continue;
+
+            const bool dealerNatural = peeks && r.dealerCardCount == 2 &&
+                r.dealerCards[0].getPoints() + r.dealerCards[1].getPoints() == 11 &&
+                (r.dealerCards[0].isAce() || r.dealerCards[1].isAce());
+
+            c.readSeats(r);
+            for (int s = 0; s < r.seatCount; ++s) {
+                const BJHistorySeat& seat = r.seats[s];
+                const BJHistorySeatKey k  = SeatKey(seat, dealerNatural);
+                if (SeatMatches(q, seat, k))
+                    out[GroupOf(group, r, upcard, seat, k)].add(seat);
+            }
+        }
+    }
+}
+
+BJHistoryResult BJRunHistoryQuery(const std::vector<std::string>& paths, const BJHistoryQuery& query,
+                                  BJHistoryGroup group, int threads)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    BJHistoryResult result;
+    result.group = group;
+    result.groups.resize(BJHistoryGroupCount(group));
+
+    std::vector<std::unique_ptr<BJHandHistoryFile>> files;
+    for (const auto& p : paths)
+        files.emplace_back(new BJHandHistoryFile(p));
+
+    // block pushdown: cut the blocks whose count range misses the filter,
+    // and chop what is left into runs
+    std::vector<BJHistoryRun> runs;
+    const bool countFilter = query.filtersCount();
+    for (int f = 0; f < (int)files.size(); ++f) {
+        const BJHandHistoryFile& file = *files[f];
+        bool open = false;
+        for (int b = 0; b < file.getBlockCount(); ++b) {
+            const BJHistoryBlockInfo& bi = file.getBlock(b);
+            if (countFilter && (bi.countMax < query.countMin || bi.countMin > query.countMax)) {
+                ++result.blocksSkipped;
+                result.roundsSkipped += bi.rounds;
+                open = false;
+                continue;
+            }
+            ++result.blocksScanned;
+            result.bytesScanned += bi.bytes;
+            if (!open || runs.back().bytes >= BJHistoryRunBytes)
+                runs.push_back({ f, b, b, 0 });
+            runs.back().last   = b;
+            runs.back().bytes += bi.bytes;
+            open = true;
+        }
+    }
+
+    const int runCount = (int)runs.size();
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads < 1)
+        threads = 1;
+    if (threads > runCount)
+        threads = runCount > 0 ? runCount : 1;
+    result.threads = threads;
+
+    const int groupCount = (int)result.groups.size();
+    std::vector<std::vector<BJHistoryTotals>> perRun(runCount);
+    std::vector<std::uint64_t>                perRunRounds(runCount, 0);
+    std::vector<std::exception_ptr>           errors(runCount);
+    std::vector<std::thread>                  workers;
+    std::atomic<int>                          nextRun(0);
+
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&]() {
+            for (int k = nextRun++; k < runCount; k = nextRun++) {
+                try {
+                    // accumulate locally so workers never share a cache line
+                    std::vector<BJHistoryTotals> local(groupCount);
+                    std::uint64_t rounds = 0;
+                    ScanRun(*files[runs[k].file], runs[k], query, group, local, rounds);
+                    perRun[k]       = std::move(local);
+                    perRunRounds[k] = rounds;
+                } catch (...) {
+                    errors[k] = std::current_exception();
+                    nextRun   = runCount;
+                }
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    for (int k = 0; k < runCount; ++k) {
+        if (errors[k])
+            std::rethrow_exception(errors[k]);
+    }
+    for (int k = 0; k < runCount; ++k) {
+        for (int g = 0; g < groupCount; ++g)
+            result.groups[g].merge(perRun[k][g]);
+        result.roundsScanned += perRunRounds[k];
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------
+#ifndef BJHistoryQueryH
+#define BJHistoryQueryH
+//---------------------------------------------------------------------------
+
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BJHandHistory.h"
+#include "BJStatistics.h"
+
+// ---------------- QUERY ----------------
+
+// Which seat-rounds of an archive a query keeps. Every field defaults to
+// "any". The seat's starting hand is its first two cards (the first card of
+// each hand after a split), its first action is read back from the record:
+// a split, then surrender, double, a hit when the hand drew, a stand when
+// it kept two cards, and BJNoAction for a natural, or for every seat when
+// a peeking dealer had one, as the simulator files them.
+struct BJHistoryQuery {
+    int upcard      = 0;                // dealer upcard class 1 (ace) .. 10
+    int totalMin    = 0;                // starting total, soft totals count the ace as 11
+    int totalMax    = 21;
+    int soft        = -1;               // 0 hard, 1 soft starting hands
+    int pair        = -1;               // 0 non-pairs, 1 pairs (equal points, as splits go)
+    int action      = -1;               // first action: a BJAction, or BJNoAction
+    int countMin    = INT_MIN;          // true count at the deal, in tenths
+    int countMax    = INT_MAX;
+    int outcome     = -2;               // sign of the seat's net: -1, 0 or +1
+    int seat        = -1;               // 0-based
+
+    // Either bound of the count filter set.
+    bool filtersCount() const { return countMin != INT_MIN || countMax != INT_MAX; }
+};
+
+// How matching seat-rounds are grouped.
+enum class BJHistoryGroup : std::uint8_t {
+    None,       // one group
+    Upcard,     // 11 groups, by upcard class (0 unused)
+    Total,      // 22 groups, by starting total (0-3 unused)
+    Action,     // BJFirstActionSlots groups
+    TrueCount,  // BJHistoryCountGroups groups, by true count rounded toward zero
+    Seat        // BJHistoryMaxSeats groups
+};
+
+constexpr int BJHistoryCountClamp  = 10;                            // beyond +/-10 share the end groups
+constexpr int BJHistoryCountGroups = 2 * BJHistoryCountClamp + 1;   // group = count + clamp
+
+int         BJHistoryGroupCount(BJHistoryGroup g);
+const char* BJHistoryGroupName(BJHistoryGroup g);
+
+// Group label, e.g. "A" for upcard group 1 or "+3" for count group 13.
+std::string BJHistoryGroupLabel(BJHistoryGroup g, int group);
+
+// ---------------- ACCUMULATOR ----------------
+
+// What a query sums over its seat-rounds. Counts and chips are exact in any
+// merge order; the per-bet moments agree to rounding.
+struct BJHistoryTotals {
+    std::uint64_t seatRounds = 0;
+    std::uint64_t hands      = 0;
+    std::uint64_t wins = 0, pushes = 0, losses = 0;     // by the seat's net
+    long long     net        = 0;                       // chips
+    long long     wagered    = 0;                       // initial bets
+    BJMoments     perBet;                               // net / bet
+
+    void add(const BJHistorySeat& s) {
+        ++seatRounds;
+        hands   += (std::uint64_t)s.handCount;
+        net     += s.net;
+        wagered += s.bet;
+        if (s.net > 0)      ++wins;
+        else if (s.net < 0) ++losses;
+        else                ++pushes;
+        if (s.bet > 0)
+            perBet.add((double)s.net / (double)s.bet);
+    }
+
+    void merge(const BJHistoryTotals& o);
+};
+
+struct BJHistoryResult {
+    BJHistoryGroup               group = BJHistoryGroup::None;
+    std::vector<BJHistoryTotals> groups;
+
+    std::uint64_t roundsScanned  = 0;   // rounds decoded
+    std::uint64_t roundsSkipped  = 0;   // rounds in blocks the index ruled out
+    int           blocksScanned  = 0;
+    int           blocksSkipped  = 0;
+    std::uint64_t bytesScanned   = 0;   // block payloads decoded
+    int           threads        = 0;
+    double        seconds        = 0.0;
+
+    BJHistoryTotals total() const;
+};
+
+// ---------------- RUNNER ----------------
+
+constexpr std::size_t BJHistoryRunBytes = 8 * 1024 * 1024;
+
+// Runs a query over one or more archives. The filters are pushed down as
+// far as the format allows: the count range in the index rules out whole
+// blocks, the count and upcard are checked before a round's seats are
+// decoded, and the seat filters before a seat is added.
+//
+// Blocks that survive the index are cut into runs of about
+// BJHistoryRunBytes, in file order, and threads claim runs as they finish;
+// each run starts with a read-ahead hint for its bytes, so the disk sees a
+// few long sequential reads at a time. Every run fills its own totals and
+// the runs are merged in file order, so the result is bit-identical for any
+// thread count. threads 0 uses every hardware thread. Throws
+// std::runtime_error for a file that is not an archive or a block that does
+// not decode.
+BJHistoryResult BJRunHistoryQuery(const std::vector<std::string>& paths, const BJHistoryQuery& query,
+                                  BJHistoryGroup group = BJHistoryGroup::None, int threads = 0);
+
+//---------------------------------------------------------------------------
+#endif
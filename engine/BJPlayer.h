@@ -0,0 +1,105 @@
+//---------------------------------------------------------------------------
+#ifndef BJPlayerH
+#define BJPlayerH
+//---------------------------------------------------------------------------
+
+#include <stdexcept>
+
+#include "BJHand.h"
+
+// ---------------- PLAYER ----------------
+
+class BJPlayer {
+private:
+    int     id;
+    BJHand  hand;
+    BJHand  splitHand;
+    bool    hasSplit;
+    int     chips;
+    int     currentBet;
+    int     splitBet;
+
+    int lastOutcomeMain;
+    int lastOutcomeSplit;
+
+    bool bankrupt;
+
+    bool actedMain;
+    bool actedSplit;
+
+public:
+    BJPlayer(int id, int initial_chips)
+        : id(id),
+          hand(),
+          splitHand(),
+          hasSplit(false),
+          chips(initial_chips),
+          currentBet(0),
+          splitBet(0),
+          lastOutcomeMain(0),
+          lastOutcomeSplit(0),
+          bankrupt(false),
+          actedMain(false),
+          actedSplit(false)
+    {}
+
+    int getID() const { return id; }
+
+    BJHand&       GetHand()       noexcept { return hand; }
+    const BJHand& GetHand() const noexcept { return hand; }
+
+    BJHand&       GetSplitHand()       noexcept { return splitHand; }
+    const BJHand& GetSplitHand() const noexcept { return splitHand; }
+
+    bool hasSplitHand() const noexcept { return hasSplit; }
+    void setHasSplit(bool v) noexcept  { hasSplit = v; }
+
+    int  getChips() const        noexcept { return chips; }
+    void adjustChips(int amount) noexcept { chips += amount; }
+
+    void setBet(int amount) {
+        if (amount < 0) throw std::invalid_argument("Bet cannot be negative");
+        currentBet = amount;
+    }
+    int getBet() const noexcept { return currentBet; }
+
+    void setSplitBet(int amount) {
+        if (amount < 0) throw std::invalid_argument("Bet cannot be negative");
+        splitBet = amount;
+    }
+    int getSplitBet() const noexcept { return splitBet; }
+
+    void clearHands() {
+        hand.clear();
+        splitHand.clear();
+        hasSplit = false;
+
+        lastOutcomeMain  = 0;
+        lastOutcomeSplit = 0;
+
+        actedMain  = false;
+        actedSplit = false;
+    }
+
+    void setRoundOutcomeMain(int o)  noexcept { lastOutcomeMain  = o; }
+    void setRoundOutcomeSplit(int o) noexcept { lastOutcomeSplit = o; }
+    int  getRoundOutcomeMain() const noexcept { return lastOutcomeMain; }
+    int  getRoundOutcomeSplit() const noexcept { return lastOutcomeSplit; }
+
+    bool isBankrupt() const noexcept { return bankrupt; }
+    void setBankrupt(bool v) noexcept { bankrupt = v; }
+
+    bool hasActedOnHand(int handIndex) const noexcept {
+        return (handIndex == 0 ? actedMain : actedSplit);
+    }
+
+    void markActionOnHand(int handIndex) noexcept {
+        if (handIndex == 0)
+            actedMain = true;
+        else
+            actedSplit = true;
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
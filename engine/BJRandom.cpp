@@ -0,0 +1,16 @@
+//---------------------------------------------------------------------------
+#include "BJRandom.h"
+
+#include <chrono>
+#include <random>
+//---------------------------------------------------------------------------
+
+std::uint64_t BJRandomSeed()
+{
+    std::random_device rd;
+    auto timeSeed = std::chrono::high_resolution_clock::now()
+                        .time_since_epoch().count();
+
+    std::uint64_t seed = ((std::uint64_t)rd() << 32) ^ (std::uint64_t)rd();
+    return seed ^ (std::uint64_t)timeSeed;
+}
@@ -0,0 +1,291 @@
+//---------------------------------------------------------------------------
+#ifndef BJRandomH
+#define BJRandomH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+// Small, fast generators for shuffling. Each one is a
+// UniformRandomBitGenerator with 64-bit output and a seed(uint64_t) that
+// expands the seed through SplitMix64, so any of them can be dropped into
+// BJBasicShoe<Engine>.
+
+// Non-deterministic seed (random_device mixed with the clock), for
+// interactive play where runs need not be reproducible.
+std::uint64_t BJRandomSeed();
+
+// ---------------- SPLITMIX64 ----------------
+
+class BJSplitMix64 {
+private:
+    std::uint64_t state;
+
+public:
+    typedef std::uint64_t result_type;
+
+    explicit BJSplitMix64(std::uint64_t s = 0) : state(s) {}
+
+    void seed(std::uint64_t s) noexcept { state = s; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~(result_type)0; }
+
+    result_type operator()() noexcept {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+// ---------------- XOSHIRO256** ----------------
+
+class BJXoshiro256ss {
+private:
+    std::uint64_t s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    typedef std::uint64_t result_type;
+
+    explicit BJXoshiro256ss(std::uint64_t seedValue = 0) { seed(seedValue); }
+
+    void seed(std::uint64_t seedValue) noexcept {
+        BJSplitMix64 sm(seedValue);
+        for (auto& word : s)
+            word = sm();
+    }
+
+    // The raw state, for saving a shoe mid-stream and carrying on later.
+    void getState(std::uint64_t (&out)[4]) const noexcept {
+        for (int i = 0; i < 4; ++i) out[i] = s[i];
+    }
+    void setState(const std::uint64_t (&in)[4]) noexcept {
+        for (int i = 0; i < 4; ++i) s[i] = in[i];
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~(result_type)0; }
+
+    result_type operator()() noexcept {
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+    }
+
+    // Advances the state by 2^128 draws (jump) or 2^192 draws (longJump),
+    // the standard way to carve non-overlapping substreams out of one seed.
+    void jump() noexcept {
+        static const std::uint64_t J[4] = {
+            0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+            0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+        };
+        applyJump(J);
+    }
+
+    void longJump() noexcept {
+        static const std::uint64_t J[4] = {
+            0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+            0x77710069854EE241ull, 0x39109BB02ACBE635ull
+        };
+        applyJump(J);
+    }
+
+private:
+    void applyJump(const std::uint64_t (&J)[4]) noexcept {
+        std::uint64_t t[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (J[i] & ((std::uint64_t)1 << b)) {
+                    t[0] ^= s[0];
+                    t[1] ^= s[1];
+                    t[2] ^= s[2];
+                    t[3] ^= s[3];
+                }
+                (*this)();
+            }
+        }
+        s[0] = t[0];
+        s[1] = t[1];
+        s[2] = t[2];
+        s[3] = t[3];
+    }
+};
+
+// ---------------- PCG64 (XSL RR 128/64) ----------------
+
+// 128-bit LCG state with the XSL-RR output permutation. The 128-bit
+// arithmetic is spelled out in 64-bit halves so the engine does not depend
+// on a compiler __int128 extension.
+class BJPcg64 {
+private:
+    struct U128 {
+        std::uint64_t hi, lo;
+    };
+
+    U128 state;
+    U128 inc;
+
+    static constexpr U128 Mul = { 2549297995355413924ull, 4865540595714422341ull };
+
+    static U128 add(U128 a, U128 b) noexcept {
+        U128 r;
+        r.lo = a.lo + b.lo;
+        r.hi = a.hi + b.hi + (r.lo < a.lo ? 1 : 0);
+        return r;
+    }
+
+    // Low 128 bits of a * b.
+    static U128 mul(U128 a, U128 b) noexcept {
+        const std::uint64_t aLo = a.lo & 0xFFFFFFFFull, aHi = a.lo >> 32;
+        const std::uint64_t bLo = b.lo & 0xFFFFFFFFull, bHi = b.lo >> 32;
+
+        const std::uint64_t ll = aLo * bLo;
+        const std::uint64_t lh = aLo * bHi;
+        const std::uint64_t hl = aHi * bLo;
+        const std::uint64_t hh = aHi * bHi;
+
+        const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+
+        U128 r;
+        r.lo = (mid << 32) | (ll & 0xFFFFFFFFull);
+        r.hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32)
+             + a.hi * b.lo + a.lo * b.hi;
+        return r;
+    }
+
+    void step() noexcept { state = add(mul(state, Mul), inc); }
+
+public:
+    typedef std::uint64_t result_type;
+
+    explicit BJPcg64(std::uint64_t seedValue = 0) { seed(seedValue); }
+
+    void seed(std::uint64_t seedValue) noexcept {
+        BJSplitMix64 sm(seedValue);
+        U128 init;
+        init.hi = sm();
+        init.lo = sm();
+        inc.hi  = sm();
+        inc.lo  = sm() | 1u;
+
+        state = U128{ 0, 0 };
+        step();
+        state = add(state, init);
+        step();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~(result_type)0; }
+
+    result_type operator()() noexcept {
+        step();
+        const std::uint64_t x   = state.hi ^ state.lo;
+        const unsigned      rot = (unsigned)(state.hi >> 58);
+        return (x >> rot) | (x << ((64 - rot) & 63));
+    }
+
+    // Skips deltaHi * 2^64 + deltaLo draws in O(log delta) (Brown's LCG
+    // jump-ahead).
+    void advance(std::uint64_t deltaHi, std::uint64_t deltaLo) noexcept {
+        U128 accMult = { 0, 1 };
+        U128 accPlus = { 0, 0 };
+        U128 curMult = Mul;
+        U128 curPlus = inc;
+
+        while (deltaHi | deltaLo) {
+            if (deltaLo & 1) {
+                accMult = mul(accMult, curMult);
+                accPlus = add(mul(accPlus, curMult), curPlus);
+            }
+            curPlus = mul(add(curMult, U128{ 0, 1 }), curPlus);
+            curMult = mul(curMult, curMult);
+
+            deltaLo = (deltaLo >> 1) | (deltaHi << 63);
+            deltaHi >>= 1;
+        }
+        state = add(mul(accMult, state), accPlus);
+    }
+
+    // Substreams 2^96 and 2^112 draws apart.
+    void jump()     noexcept { advance((std::uint64_t)1 << 32, 0); }
+    void longJump() noexcept { advance((std::uint64_t)1 << 48, 0); }
+};
+
+// ---------------- STREAM SPLITTING ----------------
+
+// Hands out non-overlapping substreams of one master seed: stream k is the
+// master engine jumped k times. Handing stream k to table k (never to
+// "whichever thread asks first") keeps a run reproducible whatever the
+// thread count. Engine needs jump().
+template <class Engine>
+class BJStreamSplitter {
+private:
+    Engine base;
+
+public:
+    explicit BJStreamSplitter(std::uint64_t masterSeed) : base(masterSeed) {}
+
+    // Next substream in order; O(1) jumps per call.
+    Engine next() {
+        Engine e = base;
+        base.jump();
+        return e;
+    }
+
+    // Substream k of the master seed, independent of any next() calls.
+    static Engine stream(std::uint64_t masterSeed, std::uint64_t k) {
+        Engine e(masterSeed);
+        for (std::uint64_t i = 0; i < k; ++i)
+            e.jump();
+        return e;
+    }
+};
+
+// ---------------- BOUNDED DRAWS ----------------
+
+// Unbiased integer in [0, bound) using Lemire's multiply-shift rejection;
+// bound must fit in 32 bits, which covers any shoe.
+template <class Engine>
+inline std::uint32_t BJRandomBelow(Engine& rng, std::uint32_t bound) noexcept
+{
+    std::uint64_t m = (std::uint64_t)(std::uint32_t)(rng() >> 32) * bound;
+    std::uint32_t low = (std::uint32_t)m;
+
+    if (low < bound) {
+        const std::uint32_t threshold = (std::uint32_t)(0u - bound) % bound;
+        while (low < threshold) {
+            m   = (std::uint64_t)(std::uint32_t)(rng() >> 32) * bound;
+            low = (std::uint32_t)m;
+        }
+    }
+    return (std::uint32_t)(m >> 32);
+}
+
+// Uniform float in [0, 1).
+template <class Engine>
+inline float BJRandomUnitFloat(Engine& rng) noexcept
+{
+    return (float)(rng() >> 40) * (1.0f / 16777216.0f);
+}
+
+// Uniform double in [0, 1) with 53 random bits.
+template <class Engine>
+inline double BJRandomUnitDouble(Engine& rng) noexcept
+{
+    return (double)(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,282 @@
+//---------------------------------------------------------------------------
+#include "BJReplay.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+//---------------------------------------------------------------------------
+
+// ---------------- ROUND LOG ----------------
+
+void BJRoundLog::assign(const Header& h, std::vector<std::uint8_t> data, std::uint64_t roundCount)
+{
+    if (h.chips.empty() || (int)h.chips.size() > MaxSeats)
+        throw std::invalid_argument("Round log holds 1-7 seats");
+
+    header    = h;
+    bytes     = std::move(data);
+    rounds    = roundCount;
+    lastChips = header.chips;
+}
+
+// ---------------- FILE FORMAT ----------------
+
+static const char BJRoundLogMagic[4] = { 'B', 'J', 'R', 'L' };
+
+enum : std::uint8_t {
+    RuleHitSoft17        = 1,
+    RuleDoubleAfterSplit = 2,
+    RuleDoubleAnyTwo     = 4,
+    RuleResplitAces      = 8,
+    RuleLateSurrender    = 16,
+    RuleDealerPeek       = 32
+};
+
+static void PutU64(std::ostream& out, std::uint64_t v)
+{
+    char b[8];
+    for (int i = 0; i < 8; ++i)
+        b[i] = (char)(v >> (8 * i));
+    out.write(b, 8);
+}
+
+static std::uint64_t GetU64(std::istream& in)
+{
+    unsigned char b[8];
+    if (!in.read((char*)b, 8))
+        throw std::runtime_error("Round log truncated");
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i)
+        v |= (std::uint64_t)b[i] << (8 * i);
+    return v;
+}
+
+static std::uint8_t GetU8(std::istream& in)
+{
+    char c;
+    if (!in.get(c))
+        throw std::runtime_error("Round log truncated");
+    return (std::uint8_t)c;
+}
+
+void BJWriteRoundLog(std::ostream& out, const BJRoundLog& log)
+{
+    const BJRoundLog::Header& h = log.getHeader();
+    const BJRuntimeRules&     r = h.rules;
+
+    std::uint8_t rules = 0;
+    if (r.hit_soft_17)        rules |= RuleHitSoft17;
+    if (r.double_after_split) rules |= RuleDoubleAfterSplit;
+    if (r.double_any_two)     rules |= RuleDoubleAnyTwo;
+    if (r.resplit_aces)       rules |= RuleResplitAces;
+    if (r.late_surrender)     rules |= RuleLateSurrender;
+    if (r.dealer_peek)        rules |= RuleDealerPeek;
+
+    out.write(BJRoundLogMagic, 4);
+    out.put((char)BJRoundLog::Version);
+    PutU64(out, h.seed);
+    out.put((char)rules);
+    out.put((char)r.max_split_hands);
+    out.put((char)r.blackjack_numer);
+    out.put((char)r.blackjack_denom);
+    out.put((char)h.deckCount);
+
+    std::uint64_t pen;
+    std::memcpy(&pen, &h.penetration, sizeof pen);
+    PutU64(out, pen);
+
+    out.put((char)h.dealOrder);
+    out.put((char)h.chips.size());
+    for (int c : h.chips)
+        PutU64(out, (std::uint64_t)(std::int64_t)c);
+
+    out.put((char)(h.resumed ? 1 : 0));
+    if (h.resumed) {
+        std::vector<std::uint8_t> shoe;
+        BJEncodeShoe(shoe, h.shoe);
+        PutU64(out, shoe.size());
+        out.write((const char*)shoe.data(), (std::streamsize)shoe.size());
+    }
+
+    PutU64(out, log.getRoundCount());
+    PutU64(out, log.getBytes().size());
+    out.write((const char*)log.getBytes().data(), (std::streamsize)log.getBytes().size());
+
+    if (!out)
+        throw std::runtime_error("Could not write round log");
+}
+
+BJRoundLog BJReadRoundLog(std::istream& in)
+{
+    char magic[4];
+    if (!in.read(magic, 4) || std::memcmp(magic, BJRoundLogMagic, 4) != 0)
+        throw std::runtime_error("Not a round log");
+
+    const std::uint8_t version = GetU8(in);
+    if (version != BJRoundLog::Version)
+        throw std::runtime_error("Unsupported round log version " + std::to_string(version));
+
+    BJRoundLog::Header h;
+    h.seed = GetU64(in);
+
+    const std::uint8_t rules = GetU8(in);
+    BJRuntimeRules& r = h.rules;
+    r.hit_soft_17        = (rules & RuleHitSoft17) != 0;
+    r.double_after_split = (rules & RuleDoubleAfterSplit) != 0;
+    r.double_any_two     = (rules & RuleDoubleAnyTwo) != 0;
+    r.resplit_aces       = (rules & RuleResplitAces) != 0;
+    r.late_surrender     = (rules & RuleLateSurrender) != 0;
+    r.dealer_peek        = (rules & RuleDealerPeek) != 0;
+    r.max_split_hands    = GetU8(in);
+    r.blackjack_numer    = GetU8(in);
+    r.blackjack_denom    = GetU8(in);
+
+    h.deckCount = GetU8(in);
+    const std::uint64_t pen = GetU64(in);
+    std::memcpy(&h.penetration, &pen, sizeof pen);
+
+    const std::uint8_t order = GetU8(in);
+    if (order > (std::uint8_t)BJDealOrder::Table)
+        throw std::runtime_error("Bad deal order in round log");
+    h.dealOrder = (BJDealOrder)order;
+
+    h.chips.resize(GetU8(in));
+    for (int& c : h.chips)
+        c = (int)(std::int64_t)GetU64(in);
+
+    h.resumed = GetU8(in) != 0;
+    if (h.resumed) {
+        std::vector<std::uint8_t> shoe((std::size_t)GetU64(in));
+        if (!shoe.empty() && !in.read((char*)shoe.data(), (std::streamsize)shoe.size()))
+            throw std::runtime_error("Round log truncated");
+        const std::uint8_t* p = shoe.data();
+        h.shoe = BJDecodeShoe(p, p + shoe.size());
+    }
+
+    const std::uint64_t rounds = GetU64(in);
+    const std::uint64_t size   = GetU64(in);
+
+    std::vector<std::uint8_t> data(size);
+    if (size && !in.read((char*)data.data(), (std::streamsize)size))
+        throw std::runtime_error("Round log truncated");
+
+    BJRoundLog log;
+    log.assign(h, std::move(data), rounds);
+    return log;
+}
+
+// ---------------- REPLAY ----------------
+
+BJRoundReplayer::BJRoundReplayer(const BJRoundLog& roundLog)
+    : log(roundLog),
+      game(roundLog.getSeatCount(), 0, roundLog.getHeader().deckCount,
+           roundLog.getHeader().penetration, roundLog.getHeader().rules),
+      pos(roundLog.getBytes().data()),
+      end(roundLog.getBytes().data() + roundLog.getBytes().size()),
+      round(0),
+      dealerPlayed(false)
+{
+    if (log.getHeader().resumed)
+        BJRestoreShoe(game.GetShoe(), log.getHeader().shoe);
+    else
+        game.GetShoe().seed(log.getHeader().seed);
+    for (int i = 0; i < game.getPlayerCount(); ++i)
+        game.GetPlayer(i).adjustChips(log.getHeader().chips[i]);
+}
+
+void BJRoundReplayer::fail(const char* what) const
+{
+    throw std::runtime_error("Replay diverged at round " + std::to_string(round + 1) + ": " + what);
+}
+
+std::uint8_t BJRoundReplayer::getByte()
+{
+    if (pos == end)
+        fail("log ends mid-round");
+    return *pos++;
+}
+
+std::uint64_t BJRoundReplayer::getVarint()
+{
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const std::uint8_t b = getByte();
+        v |= (std::uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            return v;
+    }
+    fail("bad varint");
+}
+
+void BJRoundReplayer::next()
+{
+    const int seats = game.getPlayerCount();
+
+    if (getVarint() != BJRoundLogShoePosition(game.GetShoe()))
+        fail("shoe position");
+
+    const std::uint8_t bankrupt = getByte();
+    for (int i = 0; i < seats; ++i) {
+        BJPlayer& p = game.GetPlayer(i);
+        const std::uint64_t bet = getVarint();
+        const std::uint64_t zz  = getVarint();
+        const std::int64_t  add = (std::int64_t)(zz >> 1) ^ -(std::int64_t)(zz & 1);
+
+        p.setBankrupt((bankrupt >> i) & 1);
+        p.adjustChips((int)(add - (std::int64_t)bet));
+        p.setBet((int)bet);
+        p.setSplitBet(0);
+    }
+
+    if (log.getHeader().dealOrder == BJDealOrder::Engine) {
+        game.startRound();
+    } else {
+        game.resetForNextRound();
+        BJShoe& shoe = game.GetShoe();
+        for (int k = 0; k < 2; ++k) {
+            for (int i = 0; i < seats; ++i)
+                shoe.dealCardTo(game.GetPlayer(i).GetHand());
+            shoe.dealCardTo(game.GetDealer().GetHand());
+        }
+    }
+
+    for (;;) {
+        const std::uint8_t b = getByte();
+        if (b & 0x80) {
+            dealerPlayed = (b & 1) != 0;
+            break;
+        }
+
+        const BJAction a = (BJAction)(b & 7);
+        if ((b >> 4) != game.getCurrentPlayerIndex() || ((b >> 3) & 1) != game.getCurrentHandIndex())
+            fail("seat or hand out of turn");
+
+        switch (a) {
+            case BJAction::Stand:     game.standCurrentHand();     break;
+            case BJAction::Hit:       game.hitCurrentHand();       break;
+            case BJAction::Double:    game.doubleCurrentHand();    break;
+            case BJAction::Split:     game.splitCurrentHand();     break;
+            case BJAction::Surrender: game.surrenderCurrentHand(); break;
+            default:                  fail("bad action");
+        }
+    }
+
+    if (dealerPlayed)
+        game.resolveDealerHand();
+    game.settleBets();
+
+    std::uint32_t check = 0;
+    for (int i = 0; i < 4; ++i)
+        check |= (std::uint32_t)getByte() << (8 * i);
+    if (check != BJRoundLogChecksum(game))
+        fail("chips or shoe differ after settlement");
+
+    ++round;
+}
+
+void BJRoundReplayer::replayTo(std::uint64_t n)
+{
+    while (round < n && !done())
+        next();
+}
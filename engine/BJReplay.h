@@ -0,0 +1,261 @@
+//---------------------------------------------------------------------------
+#ifndef BJReplayH
+#define BJReplayH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "BJGame.h"
+#include "BJRound.h"
+#include "BJSnapshot.h"
+
+// ---------------- ROUND LOG ----------------
+
+// How a round's first cards leave the shoe.
+enum class BJDealOrder : std::uint8_t {
+    Engine = 0,     // BJBasicGame::startRound: two cards a live seat, then the dealer
+    Table           // the app's animated deal: one card round every seat and the dealer, twice
+};
+
+// Every round played since start(): the shoe's seed and the table once,
+// then per round the bets and each call made on a seat's hands, in order.
+// Cards are never stored. Replaying the calls against a BJGame whose shoe
+// had the same seed deals the same cards, so any round can be rebuilt
+// exactly from a few bytes. A log started with resume() holds the shoe's
+// saved state instead of a seed.
+//
+// A round record (varints are LEB128, zigzag where signed):
+//     varint   shoe position the round deals from (after a due reshuffle)
+//     byte     bankrupt seats, bit i for seat i
+//     per seat varint bet, zigzag chips added outside play since the last round
+//     per call byte action | hand << 3 | seat << 4
+//     byte     0x80, | 1 when resolveDealerHand() ran
+//     u32      checksum of the seats' chips and the shoe position after settlement
+//
+// The bytes are plain and read front to back, so replay never seeks or
+// allocates.
+class BJRoundLog {
+public:
+    static constexpr int           MaxSeats = 7;
+    static constexpr std::uint8_t  Version  = 1;
+
+    struct Header {
+        std::uint64_t    seed        = 0;
+        BJRuntimeRules   rules;
+        int              deckCount   = 1;
+        double           penetration = 0.75;
+        BJDealOrder      dealOrder   = BJDealOrder::Engine;
+        std::vector<int> chips;          // per seat when recording started
+        bool             resumed     = false;
+        BJShoeState      shoe;           // resumed: the shoe as it stood
+    };
+
+private:
+    Header                    header;
+    std::vector<std::uint8_t> bytes;
+    std::uint64_t             rounds;
+    std::vector<int>          lastChips;
+
+    void putByte(std::uint8_t b) { bytes.push_back(b); }
+    void putVarint(std::uint64_t v) {
+        while (v >= 0x80) {
+            bytes.push_back((std::uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        bytes.push_back((std::uint8_t)v);
+    }
+    void putZigzag(std::int64_t v) {
+        putVarint(((std::uint64_t)v << 1) ^ (std::uint64_t)(v >> 63));
+    }
+    void putU32(std::uint32_t v) {
+        for (int i = 0; i < 4; ++i)
+            bytes.push_back((std::uint8_t)(v >> (8 * i)));
+    }
+
+    // Header fields other than the shoe's; empties the log.
+    template <class Game>
+    void noteTable(const Game& g, BJDealOrder order);
+
+public:
+    BJRoundLog() : rounds(0) {}
+
+    // Starts a new log on g: reseeds its shoe with seed (which reshuffles
+    // it) and notes the table as it stands.
+    template <class Game>
+    void start(Game& g, std::uint64_t seed, BJDealOrder order = BJDealOrder::Engine);
+
+    // Starts a new log on g with its shoe left as it is, e.g. restored from
+    // a snapshot; the log keeps the shoe's state in place of a seed.
+    template <class Game>
+    void resume(Game& g, BJDealOrder order = BJDealOrder::Engine);
+
+    // After the bets are placed, before the deal.
+    template <class Game>
+    void beginRound(const Game& g);
+
+    // Just before hitCurrentHand(), standCurrentHand(), doubleCurrentHand(),
+    // splitCurrentHand() or surrenderCurrentHand(); a BJPlayRound observer.
+    template <class Game>
+    void action(const Game& g, BJAction a) {
+        putByte((std::uint8_t)((int)a | g.getCurrentHandIndex() << 3 | g.getCurrentPlayerIndex() << 4));
+    }
+
+    // After settleBets(). dealerPlayed: resolveDealerHand() was called.
+    template <class Game>
+    void endRound(const Game& g, bool dealerPlayed);
+
+    const Header&                    getHeader()     const noexcept { return header; }
+    const std::vector<std::uint8_t>& getBytes()      const noexcept { return bytes; }
+    std::uint64_t                    getRoundCount() const noexcept { return rounds; }
+    int                              getSeatCount()  const noexcept { return (int)header.chips.size(); }
+
+    // Rebuilds a log read back from storage; the bytes must hold whole
+    // rounds.
+    void assign(const Header& h, std::vector<std::uint8_t> data, std::uint64_t roundCount);
+};
+
+// Position a shoe will deal the next round from: 0 when it is due a
+// reshuffle, else where it stands.
+template <class Shoe>
+inline std::uint64_t BJRoundLogShoePosition(const Shoe& shoe)
+{
+    return shoe.needsReshuffle() ? 0 : (std::uint64_t)shoe.getDealtCount();
+}
+
+template <class Game>
+std::uint32_t BJRoundLogChecksum(const Game& g)
+{
+    std::uint32_t h = 2166136261u;                  // FNV-1a
+    auto mix = [&h](std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) {
+            h ^= (v >> (8 * i)) & 0xFF;
+            h *= 16777619u;
+        }
+    };
+    for (int i = 0; i < g.getPlayerCount(); ++i)
+        mix((std::uint32_t)g.GetPlayer(i).getChips());
+    mix((std::uint32_t)g.GetShoe().getDealtCount());
+    return h;
+}
+
+template <class Game>
+void BJRoundLog::noteTable(const Game& g, BJDealOrder order)
+{
+    static_assert(std::is_same<typename Game::ShoeType, BJShoe>::value,
+                  "replay deals from a BJShoe; the game must shuffle with the same engine");
+
+    if (g.getPlayerCount() > MaxSeats)
+        throw std::invalid_argument("Round log holds at most 7 seats");
+
+    header.rules       = BJRuntimeRules::from(g.GetRules());
+    header.deckCount   = g.GetShoe().getDeckCount();
+    header.penetration = g.GetShoe().getPenetration();
+    header.dealOrder   = order;
+    header.chips.resize(g.getPlayerCount());
+    for (int i = 0; i < g.getPlayerCount(); ++i)
+        header.chips[i] = g.GetPlayer(i).getChips() + g.GetPlayer(i).getBet();
+
+    lastChips = header.chips;
+    bytes.clear();
+    rounds = 0;
+}
+
+template <class Game>
+void BJRoundLog::start(Game& g, std::uint64_t seed, BJDealOrder order)
+{
+    noteTable(g, order);
+    g.GetShoe().seed(seed);
+
+    header.seed    = seed;
+    header.resumed = false;
+    header.shoe    = BJShoeState();
+}
+
+template <class Game>
+void BJRoundLog::resume(Game& g, BJDealOrder order)
+{
+    noteTable(g, order);
+    header.seed    = 0;
+    header.resumed = true;
+    header.shoe    = BJCaptureShoe(g.GetShoe());
+}
+
+template <class Game>
+void BJRoundLog::beginRound(const Game& g)
+{
+    putVarint(BJRoundLogShoePosition(g.GetShoe()));
+
+    std::uint8_t bankrupt = 0;
+    for (int i = 0; i < g.getPlayerCount(); ++i)
+        if (g.GetPlayer(i).isBankrupt())
+            bankrupt |= (std::uint8_t)(1u << i);
+    putByte(bankrupt);
+
+    // the bet has already left the stack
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        const BJPlayer& p = g.GetPlayer(i);
+        putVarint((std::uint64_t)p.getBet());
+        putZigzag((std::int64_t)p.getChips() + p.getBet() - lastChips[i]);
+    }
+}
+
+template <class Game>
+void BJRoundLog::endRound(const Game& g, bool dealerPlayed)
+{
+    putByte((std::uint8_t)(0x80 | (dealerPlayed ? 1 : 0)));
+    putU32(BJRoundLogChecksum(g));
+
+    for (int i = 0; i < g.getPlayerCount(); ++i)
+        lastChips[i] = g.GetPlayer(i).getChips();
+    ++rounds;
+}
+
+// Whole-log I/O: a "BJRL" magic, the version, the header, the round count
+// and the round bytes. Reading throws std::runtime_error on anything that
+// is not such a log.
+void       BJWriteRoundLog(std::ostream& out, const BJRoundLog& log);
+BJRoundLog BJReadRoundLog(std::istream& in);
+
+// ---------------- REPLAY ----------------
+
+// Re-executes a log round by round on a fresh BJGame built from its
+// header. No strategy is consulted and no card is stored; every call is
+// made exactly as recorded, so the game passes through the same states.
+// Each round is checked against the recorded shoe position, seats and
+// checksum; the first mismatch throws std::runtime_error naming the round.
+class BJRoundReplayer {
+private:
+    const BJRoundLog&   log;
+    BJGame              game;
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+    std::uint64_t       round;
+    bool                dealerPlayed;
+
+    [[noreturn]] void fail(const char* what) const;
+
+    std::uint8_t  getByte();
+    std::uint64_t getVarint();
+
+public:
+    explicit BJRoundReplayer(const BJRoundLog& roundLog);
+
+    bool done() const noexcept { return pos == end; }
+
+    // Replays the next round; the game is left as settlement left it.
+    void next();
+
+    // Replays up to and including round n (1-based), or to the end.
+    void replayTo(std::uint64_t n);
+
+    const BJGame& GetGame()          const noexcept { return game; }
+    std::uint64_t getRound()         const noexcept { return round; }   // rounds replayed
+    bool          getDealerPlayed()  const noexcept { return dealerPlayed; }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+#ifndef BJRoundH
+#define BJRoundH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "BJDecisionManager.h"
+#include "BJGame.h"
+
+// ---------------- ACTIONS ----------------
+
+enum class BJAction : std::uint8_t {
+    Stand = 0,
+    Hit,
+    Double,
+    Split,
+    Surrender,
+    Count
+};
+
+constexpr int BJActionCount = (int)BJAction::Count;
+
+inline const char* BJActionName(BJAction a)
+{
+    static const char* names[BJActionCount] = {
+        "stand", "hit", "double", "split", "surrender"
+    };
+    return names[(int)a];
+}
+
+// ---------------- ROUND DRIVER ----------------
+
+// Observer that ignores everything; BJPlayRound's default.
+struct BJNoRoundObserver {
+    template <class Game>
+    void action(const Game&, BJAction) {}
+};
+
+// Plays one round on a game whose bets are already placed, without any UI:
+// deal, dealer peek, every seat's decisions, dealer draw, settlement.
+//
+// Strategy is anything with
+//     BJAction decide(const Game& g, const BJPlayer& p, const BJHand& h);
+// It is asked once per decision on hands below 21. An action the rules do
+// not allow at that point (double, split, surrender) is played as a hit.
+//
+// actionCounts, when given, receives one increment per decision.
+// observer, when given, has action(g, a) called just before each call the
+// round makes on the current hand (hit, stand, double, split, surrender),
+// including the stand that closes every hand; BJRoundLog records rounds
+// this way.
+template <class Game, class Strategy, class Observer = BJNoRoundObserver>
+void BJPlayRound(Game& g, Strategy& strategy, std::uint64_t* actionCounts = nullptr,
+                 Observer* observer = nullptr)
+{
+    g.startRound();
+
+    if (g.dealerShouldPeek() && g.GetDealer().GetHand().isBlackjack()) {
+        g.settleBets();
+        return;
+    }
+
+    for (;;) {
+        BJPlayer& p = g.GetCurrentPlayer();
+
+        for (;;) {
+            const BJHand& h = g.GetCurrentHand();
+            if (h.value() >= 21)
+                break;
+
+            BJAction a = strategy.decide(g, p, h);
+
+            if ((a == BJAction::Double    && !BJDecisionManager::canDoubleDown(p, g)) ||
+                (a == BJAction::Split     && !BJDecisionManager::canSplit(p, g)) ||
+                (a == BJAction::Surrender && !BJDecisionManager::canSurrender(p, g)))
+            {
+                a = BJAction::Hit;
+            }
+
+            if (actionCounts)
+                ++actionCounts[(int)a];
+
+            if (a == BJAction::Stand)
+                break;
+            if (observer)
+                observer->action(g, a);
+            if (a == BJAction::Hit) {
+                g.hitCurrentHand();
+                continue;
+            }
+            if (a == BJAction::Split) {
+                g.splitCurrentHand();
+                continue;
+            }
+            if (a == BJAction::Double)
+                g.doubleCurrentHand();
+            else
+                g.surrenderCurrentHand();
+            break;
+        }
+
+        if (observer)
+            observer->action(g, BJAction::Stand);
+        if (!g.standCurrentHand())
+            break;
+    }
+
+    if (g.liveHandsRemain())
+        g.resolveDealerHand();
+
+    g.settleBets();
+}
+
+// BJPlayRound, recorded: log takes beginRound(g) after the bets, the
+// observer's action(g, a) calls, and endRound(g, dealerPlayed) after
+// settlement (BJRoundLog, BJHandHistoryWriter).
+template <class Game, class Strategy, class Recorder>
+void BJPlayRecordedRound(Game& g, Strategy& strategy, Recorder& log,
+                         std::uint64_t* actionCounts = nullptr)
+{
+    log.beginRound(g);
+    BJPlayRound(g, strategy, actionCounts, &log);
+    log.endRound(g, g.liveHandsRemain());
+}
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,115 @@
+//---------------------------------------------------------------------------
+#ifndef BJRulesH
+#define BJRulesH
+//---------------------------------------------------------------------------
+
+#include "BJHand.h"
+#include "BJSettlement.h"
+
+// ---------------- RULES ----------------
+
+// The game, decision manager and solvers are templated on a rules policy.
+// Both policies below expose the same const member functions; with
+// BJFixedRules every check is a constant and folds away, BJRuntimeRules
+// reads plain fields so the app can configure a table at run time.
+//
+// maxSplitHands() is the number of hands a player may end up with after
+// splitting (1 disables splitting). BJBasicGame deals at most one split
+// hand per player; the strategy solvers model resplits up to the limit.
+
+template <bool HitSoft17, bool DoubleAfterSplit, bool DoubleAnyTwo,
+          int MaxSplitHands, bool ResplitAces, bool LateSurrender,
+          int BlackjackNumer, int BlackjackDenom, bool DealerPeek>
+struct BJFixedRules {
+    static constexpr bool hitSoft17()        { return HitSoft17; }
+    static constexpr bool doubleAfterSplit() { return DoubleAfterSplit; }
+    static constexpr bool doubleAnyTwo()     { return DoubleAnyTwo; }
+    static constexpr int  maxSplitHands()    { return MaxSplitHands; }
+    static constexpr bool resplitAces()      { return ResplitAces; }
+    static constexpr bool lateSurrender()    { return LateSurrender; }
+    static constexpr int  blackjackNumer()   { return BlackjackNumer; }
+    static constexpr int  blackjackDenom()   { return BlackjackDenom; }
+    static constexpr bool dealerPeek()       { return DealerPeek; }
+
+    static constexpr BJPayoutTable payoutTable() {
+        return BJPayoutTable::make(BlackjackNumer, BlackjackDenom);
+    }
+};
+
+// Common shoe game: S17, DAS, double any two, split to 4, no RSA, late
+// surrender, 3:2, peek.
+typedef BJFixedRules<false, true, true, 4, false, true, 3, 2, true> BJRulesS17;
+// Same table hitting soft 17.
+typedef BJFixedRules<true,  true, true, 4, false, true, 3, 2, true> BJRulesH17;
+
+struct BJRuntimeRules {
+    bool hit_soft_17        = false;
+    bool double_after_split = false;
+    bool double_any_two     = false;
+    int  max_split_hands    = 2;
+    bool resplit_aces       = false;
+    bool late_surrender     = false;
+    int  blackjack_numer    = 3;
+    int  blackjack_denom    = 2;
+    bool dealer_peek        = true;
+
+    bool hitSoft17()        const { return hit_soft_17; }
+    bool doubleAfterSplit() const { return double_after_split; }
+    bool doubleAnyTwo()     const { return double_any_two; }
+    int  maxSplitHands()    const { return max_split_hands; }
+    bool resplitAces()      const { return resplit_aces; }
+    bool lateSurrender()    const { return late_surrender; }
+    int  blackjackNumer()   const { return blackjack_numer; }
+    int  blackjackDenom()   const { return blackjack_denom; }
+    bool dealerPeek()       const { return dealer_peek; }
+
+    BJPayoutTable payoutTable() const {
+        return BJPayoutTable::make(blackjack_numer, blackjack_denom);
+    }
+
+    // Captures any rules policy, e.g. to hand a BJFixedRules table to code
+    // that only takes runtime rules.
+    template <class Rules>
+    static BJRuntimeRules from(const Rules& r) {
+        BJRuntimeRules out;
+        out.hit_soft_17        = r.hitSoft17();
+        out.double_after_split = r.doubleAfterSplit();
+        out.double_any_two     = r.doubleAnyTwo();
+        out.max_split_hands    = r.maxSplitHands();
+        out.resplit_aces       = r.resplitAces();
+        out.late_surrender     = r.lateSurrender();
+        out.blackjack_numer    = r.blackjackNumer();
+        out.blackjack_denom    = r.blackjackDenom();
+        out.dealer_peek        = r.dealerPeek();
+        return out;
+    }
+
+    bool operator==(const BJRuntimeRules& o) const {
+        return hit_soft_17 == o.hit_soft_17 && double_after_split == o.double_after_split
+            && double_any_two == o.double_any_two && max_split_hands == o.max_split_hands
+            && resplit_aces == o.resplit_aces && late_surrender == o.late_surrender
+            && blackjack_numer == o.blackjack_numer && blackjack_denom == o.blackjack_denom
+            && dealer_peek == o.dealer_peek;
+    }
+    bool operator!=(const BJRuntimeRules& o) const { return !(*this == o); }
+};
+
+// ---------------- RULE HELPERS ----------------
+
+// Dealer draws below 17, and on soft 17 under H17.
+template <class Rules>
+inline bool BJDealerMustHit(const Rules& rules, const BJHand& h)
+{
+    const int v = h.value();
+    return v < 17 || (rules.hitSoft17() && v == 17 && h.isSoft());
+}
+
+// Totals a two-card hand may double on (before the split/DAS check).
+template <class Rules>
+inline bool BJDoubleAllowedOnTotal(const Rules& rules, int total)
+{
+    return rules.doubleAnyTwo() || (total >= 9 && total <= 11);
+}
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+#ifndef BJSettlementH
+#define BJSettlementH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+
+// ---------------- SETTLEMENT ----------------
+
+// One record per hand that has money on it. value is the hand's best
+// total; flags mark a natural (two-card 21 on an unsplit hand) or a
+// surrendered hand.
+enum BJSettleFlags : std::uint8_t {
+    BJSettleNone        = 0,
+    BJSettleNatural     = 1,
+    BJSettleSurrendered = 2
+};
+
+struct BJSettleRecord {
+    std::uint8_t value;
+    std::uint8_t flags;
+    std::int32_t bet;
+};
+
+// payout is what goes back to the player's chips (stake included);
+// outcome is -1 / 0 / +1 as reported through BJPlayer's round outcome.
+struct BJSettleResult {
+    std::int32_t payout;
+    std::int8_t  outcome;
+};
+
+enum BJSettleClass : std::uint8_t {
+    BJClassLose = 0,
+    BJClassPush,
+    BJClassWin,
+    BJClassNatural,
+    BJClassSurrender,
+    BJClassCount
+};
+
+// Chips returned per unit bet, in tenths so 3:2, 6:5 and surrender stay
+// exact integers; fractional chips on odd bets are rounded down.
+struct BJPayoutTable {
+    std::uint8_t returnTenths[BJClassCount];
+    std::int8_t  outcome[BJClassCount];
+
+    // Lose, push, win 1:1, natural at (numer:denom), surrender half back.
+    static constexpr BJPayoutTable make(int naturalNumer, int naturalDenom) {
+        return BJPayoutTable{
+            { 0, 10, 20, (std::uint8_t)(10 + 10 * naturalNumer / naturalDenom), 5 },
+            { -1, 0, 1, 1, -1 }
+        };
+    }
+};
+
+inline constexpr BJPayoutTable BJPayout3to2 = BJPayoutTable::make(3, 2);
+inline constexpr BJPayoutTable BJPayout6to5 = BJPayoutTable::make(6, 5);
+
+// Scores make every case one comparison: a busted player scores 0 (loses
+// even to a busted dealer), a busted dealer scores 1 (loses to any standing
+// hand) and a natural scores 22 (beats any drawn 21).
+inline int BJPlayerScore(int value, bool natural) {
+    int score = (value <= 21 ? value : 0);
+    return natural ? 22 : score;
+}
+
+inline int BJDealerScore(int value, bool natural) {
+    int score = (value <= 21 ? value : 1);
+    return natural ? 22 : score;
+}
+
+inline BJSettleClass BJClassifyHand(const BJSettleRecord& r, int dealerScore) {
+    const int playerScore = BJPlayerScore(r.value, (r.flags & BJSettleNatural) != 0);
+    const int cmp = (playerScore > dealerScore) - (playerScore < dealerScore);
+
+    int cls = cmp + 1;
+    cls += (cmp > 0) & ((r.flags & BJSettleNatural) != 0);
+    cls  = (r.flags & BJSettleSurrendered) ? (int)BJClassSurrender : cls;
+    return (BJSettleClass)cls;
+}
+
+// Settles count hands against one dealer hand.
+inline void BJSettleHands(const BJSettleRecord* records, int count,
+                          int dealerValue, bool dealerNatural,
+                          const BJPayoutTable& table, BJSettleResult* results)
+{
+    const int dealerScore = BJDealerScore(dealerValue, dealerNatural);
+
+    for (int i = 0; i < count; ++i) {
+        const BJSettleClass cls = BJClassifyHand(records[i], dealerScore);
+        results[i].payout  = records[i].bet * table.returnTenths[cls] / 10;
+        results[i].outcome = table.outcome[cls];
+    }
+}
+
+//---------------------------------------------------------------------------
+#endif
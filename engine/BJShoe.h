@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------
+#ifndef BJShoeH
+#define BJShoeH
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "BJCard.h"
+#include "BJComposition.h"
+#include "BJCount.h"
+#include "BJHand.h"
+#include "BJRandom.h"
+
+// ---------------- SHOE ----------------
+
+// 1-8 decks dealt front to back. Cards before roundStart are in the discard
+// tray, cards in [roundStart, index) are on the table. Once index passes the
+// cut card the shoe asks for a reshuffle, which the game performs between
+// rounds.
+//
+// The shuffle engine is a compile-time policy and lives as long as the
+// shoe; seed() makes the following shuffles reproducible.
+//
+// Every card drawn is counted (hole card included, as soon as it leaves the
+// shoe) and the counts restart at each shuffle.
+template <class Engine>
+class BJBasicShoe {
+public:
+    typedef Engine EngineType;
+
+    static constexpr int    MinDecks           = 1;
+    static constexpr int    MaxDecks           = 8;
+    static constexpr int    CardsPerDeck       = 52;
+    static constexpr double DefaultPenetration = 0.75;
+
+private:
+    std::vector<BJCard> cards;
+    int    index;
+    int    roundStart;
+    int    deckCount;
+    double penetration;
+    int    cutCardIndex;
+    int    shuffleCount;
+
+    Engine rng;
+
+    BJCardCounter counter;
+
+    std::function<void()> onReshuffle;
+
+    void buildCards() {
+        cards.clear();
+        cards.reserve((size_t)deckCount * CardsPerDeck);
+
+        for (int d = 0; d < deckCount; ++d) {
+            for (int s = 0; s < 4; ++s) {
+                for (int r = 2; r <= 14; ++r) {
+                    cards.emplace_back((BJSuit)s, (BJRank)r);
+                }
+            }
+        }
+    }
+
+    // Fisher-Yates over [first, last).
+    void shuffleRange(int first, int last) {
+        for (int i = last - 1; i > first; --i) {
+            int j = first + (int)BJRandomBelow(rng, (std::uint32_t)(i - first + 1));
+            std::swap(cards[i], cards[j]);
+        }
+    }
+
+    // The shoe ran dry mid-round: keep the cards on the table at the front
+    // and shuffle the discard tray in behind them, as a dealer would.
+    void refillFromDiscards() {
+        if (roundStart == 0)
+            throw std::runtime_error("Shoe empty.");
+
+        std::rotate(cards.begin(), cards.begin() + roundStart, cards.begin() + index);
+
+        int inPlay = index - roundStart;
+        index      = inPlay;
+        roundStart = 0;
+        shuffleRange(inPlay, (int)cards.size());
+        ++shuffleCount;
+
+        // the tray is unseen again; the cards on the table stay counted
+        counter.reset();
+        for (int i = 0; i < inPlay; ++i)
+            counter.add(cards[i]);
+
+        if (onReshuffle)
+            onReshuffle();
+    }
+
+public:
+    explicit BJBasicShoe(int deck_count = 1, double pen = DefaultPenetration)
+        : BJBasicShoe(deck_count, pen, BJRandomSeed()) {}
+
+    BJBasicShoe(int deck_count, double pen, std::uint64_t seedValue)
+        : index(0),
+          roundStart(0),
+          deckCount(0),
+          penetration(0.0),
+          cutCardIndex(0),
+          shuffleCount(0),
+          rng(seedValue)
+    {
+        configure(deck_count, pen);
+    }
+
+    // Rebuilds the shoe for a new deck count / cut-card position and
+    // reshuffles it.
+    void configure(int deck_count, double pen) {
+        if (deck_count < MinDecks || deck_count > MaxDecks)
+            throw std::invalid_argument("Deck count must be between 1 and 8");
+        if (!(pen > 0.0 && pen <= 1.0))
+            throw std::invalid_argument("Penetration must be in (0, 1]");
+
+        deckCount   = deck_count;
+        penetration = pen;
+        counter.reset(deckCount);
+
+        buildCards();
+
+        cutCardIndex = (int)(penetration * (double)cards.size());
+        if (cutCardIndex < 1)
+            cutCardIndex = 1;
+
+        reshuffle();
+    }
+
+    // Reseeds the engine and restarts the shoe from a freshly ordered set
+    // of decks, so the same seed always deals the same cards.
+    void seed(std::uint64_t seedValue) {
+        rng.seed(seedValue);
+        buildCards();
+        reshuffle();
+    }
+
+    // Same as seed() with a ready engine, e.g. a BJStreamSplitter substream.
+    void setEngine(const Engine& e) {
+        rng = e;
+        buildCards();
+        reshuffle();
+    }
+
+    Engine&       GetEngine()       noexcept { return rng; }
+    const Engine& GetEngine() const noexcept { return rng; }
+
+    // Gathers the discard tray and every dealt card back into the shoe,
+    // shuffles it and fires the reshuffle event.
+    void reshuffle() {
+        index      = 0;
+        roundStart = 0;
+        shuffleRange(0, (int)cards.size());
+        ++shuffleCount;
+        counter.reset();
+
+        if (onReshuffle)
+            onReshuffle();
+    }
+
+    // Puts the shoe back where a saved one stood: the cards in order, how
+    // many were dealt and the shuffles so far, with the last round already
+    // collected. The counts are rebuilt from the cards dealt since the
+    // shuffle. Throws std::invalid_argument unless order is exactly this
+    // shoe's decks. The engine is restored separately, through GetEngine().
+    void restore(const std::vector<BJCard>& order, int dealt, int shuffles) {
+        if (order.size() != cards.size() || dealt < 0 || dealt > (int)order.size())
+            throw std::invalid_argument("Saved shoe does not match the deck count");
+
+        int seen[256] = {};
+        for (const auto& c : order)
+            ++seen[c.getCode()];
+        for (const auto& c : cards)
+            if (seen[c.getCode()]-- == 0)
+                throw std::invalid_argument("Saved shoe does not hold whole decks");
+
+        cards        = order;
+        index        = dealt;
+        roundStart   = dealt;
+        shuffleCount = shuffles;
+
+        counter.reset();
+        for (int i = 0; i < dealt; ++i)
+            counter.add(cards[i]);
+    }
+
+    // Moves the cards dealt this round to the discard tray.
+    void collectRound() noexcept { roundStart = index; }
+
+    bool needsReshuffle() const noexcept { return index >= cutCardIndex; }
+
+    BJCard DrawCard() {
+        if (index >= (int)cards.size()) {
+            refillFromDiscards();
+        }
+        const BJCard c = cards[index++];
+        counter.add(c);
+        return c;
+    }
+
+    void dealCardTo(BJHand& hand) {
+        hand.addCard(DrawCard());
+    }
+
+    // Counts of the cards not yet dealt.
+    BJShoeComposition getRemainingComposition() const {
+        return counter.remainingComposition();
+    }
+
+    const BJCardCounter& GetCounter() const noexcept { return counter; }
+
+    int    runningCount(BJCountSystem s = BJCountSystem::HiLo) const { return counter.runningCount(s); }
+    double trueCount(BJCountSystem s = BJCountSystem::HiLo)    const { return counter.trueCount(s); }
+    double decksRemaining() const { return counter.decksRemaining(); }
+
+    void setOnReshuffle(std::function<void()> handler) { onReshuffle = std::move(handler); }
+
+    // Front to back: the dealt cards, then the next one at getDealtCount().
+    const std::vector<BJCard>& GetCards() const noexcept { return cards; }
+
+    int    remaining()       const noexcept { return (int)cards.size() - index; }
+    int    size()            const noexcept { return (int)cards.size(); }
+    int    getDealtCount()   const noexcept { return index; }
+    int    getDiscardCount() const noexcept { return roundStart; }
+    int    getInPlayCount()  const noexcept { return index - roundStart; }
+    int    getDeckCount()    const noexcept { return deckCount; }
+    double getPenetration()  const noexcept { return penetration; }
+    int    getCutCardIndex() const noexcept { return cutCardIndex; }
+    int    getShuffleCount() const noexcept { return shuffleCount; }
+};
+
+typedef BJBasicShoe<BJXoshiro256ss> BJShoe;
+
+//---------------------------------------------------------------------------
+#endif
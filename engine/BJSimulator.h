@@ -0,0 +1,210 @@
+//---------------------------------------------------------------------------
+#ifndef BJSimulatorH
+#define BJSimulatorH
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "BJGame.h"
+#include "BJRandom.h"
+#include "BJRound.h"
+
+// ---------------- MONTE CARLO SIMULATOR ----------------
+
+struct BJSimConfig {
+    std::uint64_t rounds      = 1000000;
+    int           threads     = 0;       // 0 = std::thread::hardware_concurrency()
+    int           tables      = 64;      // independent tables; fixes the result, not threads
+    int           players     = 1;
+    int           deckCount   = 6;
+    double        penetration = 0.75;
+    int           baseBet     = 10;      // multiple of 10 keeps 3:2 and 6:5 exact
+    std::uint64_t seed        = 0;
+};
+
+// Per-seat-round results in units of the base bet. Each table fills its
+// own copy; they are merged after the workers join.
+struct BJSimStats {
+    std::uint64_t rounds     = 0;
+    std::uint64_t seatRounds = 0;
+    double        sumNet     = 0.0;
+    double        sumNetSq   = 0.0;
+    std::uint64_t wins       = 0;
+    std::uint64_t pushes     = 0;
+    std::uint64_t losses     = 0;
+    std::uint64_t actions[BJActionCount] = {};
+    double        seconds    = 0.0;
+
+    void addSeat(double net) {
+        ++seatRounds;
+        sumNet   += net;
+        sumNetSq += net * net;
+        if (net > 0.0)      ++wins;
+        else if (net < 0.0) ++losses;
+        else                ++pushes;
+    }
+
+    void merge(const BJSimStats& o) {
+        rounds     += o.rounds;
+        seatRounds += o.seatRounds;
+        sumNet     += o.sumNet;
+        sumNetSq   += o.sumNetSq;
+        wins       += o.wins;
+        pushes     += o.pushes;
+        losses     += o.losses;
+        for (int a = 0; a < BJActionCount; ++a)
+            actions[a] += o.actions[a];
+    }
+
+    double meanNet() const { return seatRounds ? sumNet / (double)seatRounds : 0.0; }
+
+    // Player's expected loss per unit bet, as a fraction.
+    double houseEdge() const { return -meanNet(); }
+
+    double variance() const {
+        if (seatRounds < 2) return 0.0;
+        double m = meanNet();
+        return (sumNetSq - (double)seatRounds * m * m) / (double)(seatRounds - 1);
+    }
+
+    double standardError() const {
+        return seatRounds ? std::sqrt(variance() / (double)seatRounds) : 0.0;
+    }
+
+    double roundsPerSecond() const { return seconds > 0.0 ? (double)rounds / seconds : 0.0; }
+};
+
+// ---------------- BET POLICIES ----------------
+
+// A bet policy is anything with
+//     int units(const Game& g);
+// asked before each round for every seat's bet in base-bet units (>= 1).
+struct BJFlatBet {
+    template <class Game>
+    int units(const Game&) const { return 1; }
+};
+
+// ---------------- TABLE LOOP ----------------
+
+// Plays rounds on one table, shuffling from the given engine, and
+// accumulates into stats. Net results are in base-bet units. Stats is
+// BJSimStats or anything with the same addSeat(), rounds and actions.
+template <class Rules, class Strategy, class Engine, class Stats, class BetPolicy = BJFlatBet>
+void BJSimulateTable(const BJSimConfig& cfg, const Engine& engine, std::uint64_t rounds,
+                     Strategy strategy, Stats& stats, BetPolicy bets = BetPolicy())
+{
+    // Enough chips that no seat ever runs short of a double or split; they
+    // are topped back up every round.
+    const int bankroll = cfg.baseBet * 1000;
+
+    BJBasicGame<Rules, Engine> game(cfg.players, bankroll, cfg.deckCount, cfg.penetration);
+    game.GetShoe().setEngine(engine);
+
+    const double unit = 1.0 / (double)cfg.baseBet;
+
+    for (std::uint64_t r = 0; r < rounds; ++r) {
+        // shuffle before betting, so the bet sees the fresh shoe; the round
+        // would have shuffled at the same point anyway
+        if (game.GetShoe().needsReshuffle())
+            game.GetShoe().reshuffle();
+
+        const int bet = cfg.baseBet * bets.units(game);
+        for (int i = 0; i < cfg.players; ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(bankroll - bet - p.getChips());
+            p.setBet(bet);
+            p.setSplitBet(0);
+        }
+
+        BJPlayRound(game, strategy, stats.actions);
+
+        for (int i = 0; i < cfg.players; ++i)
+            stats.addSeat((double)(game.GetPlayer(i).getChips() - bankroll) * unit);
+        ++stats.rounds;
+    }
+}
+
+// Runs fn(table, engine, rounds, stats) for each of cfg.tables tables over
+// cfg.threads workers. Table t always gets substream t of cfg.seed and a
+// fixed share of cfg.rounds, and the per-table stats are merged in table
+// order, so the result is bit-identical for any thread count. A table
+// that throws stops the tables not yet started; the exception of the
+// lowest such table is rethrown once every worker has finished.
+//
+// Stats needs merge() and a seconds field; BJSimStats is the default.
+template <class Engine, class Stats = BJSimStats, class TableFn>
+Stats BJRunTables(const BJSimConfig& cfg, TableFn fn)
+{
+    int threads = cfg.threads > 0 ? cfg.threads : (int)std::thread::hardware_concurrency();
+    if (threads < 1)
+        threads = 1;
+
+    const int tables = cfg.tables > 0 ? cfg.tables : 1;
+    if (threads > tables)
+        threads = tables;
+
+    BJStreamSplitter<Engine> splitter(cfg.seed);
+    std::vector<Engine> streams;
+    streams.reserve(tables);
+    for (int t = 0; t < tables; ++t)
+        streams.push_back(splitter.next());
+
+    std::vector<Stats>              perTable(tables);
+    std::vector<std::exception_ptr> errors(tables);
+    std::vector<std::thread>        workers;
+    std::atomic<int>                nextTable(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&]() {
+            for (int t = nextTable++; t < tables; t = nextTable++) {
+                try {
+                    std::uint64_t share = cfg.rounds / tables
+                                        + ((std::uint64_t)t < cfg.rounds % tables ? 1 : 0);
+                    // accumulate locally so workers never share a cache line
+                    Stats local;
+                    fn(t, streams[t], share, local);
+                    perTable[t] = local;
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                    nextTable = tables;
+                }
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    for (const auto& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+    Stats total;
+    for (const auto& s : perTable)
+        total.merge(s);
+
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+template <class Rules, class Strategy, class BetPolicy = BJFlatBet>
+BJSimStats BJSimulate(const BJSimConfig& cfg, const Strategy& strategy,
+                      const BetPolicy& bets = BetPolicy())
+{
+    typedef BJXoshiro256ss Engine;
+    return BJRunTables<Engine>(cfg,
+        [&cfg, &strategy, &bets](int, const Engine& engine, std::uint64_t rounds, BJSimStats& stats) {
+            BJSimulateTable<Rules>(cfg, engine, rounds, strategy, stats, bets);
+        });
+}
+
+//---------------------------------------------------------------------------
+#endif
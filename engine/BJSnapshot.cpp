@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------------
+#include "BJSnapshot.h"
+
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+//---------------------------------------------------------------------------
+
+static const char         BJSnapshotMagic[4] = { 'B', 'J', 'S', 'S' };
+static const std::uint8_t BJSnapshotVersion  = 1;
+
+static void PutLE(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back((std::uint8_t)(v >> (8 * i)));
+}
+
+static std::uint64_t GetLE(const std::uint8_t*& pos, const std::uint8_t* end, int bytes)
+{
+    if (end - pos < bytes)
+        throw std::runtime_error("Saved state truncated");
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v |= (std::uint64_t)pos[i] << (8 * i);
+    pos += bytes;
+    return v;
+}
+
+static std::uint32_t Fnv1a(const std::uint8_t* p, std::size_t n)
+{
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// ---------------- SHOE STATE ----------------
+
+BJShoeState BJCaptureShoe(const BJShoe& shoe)
+{
+    BJShoeState st;
+    st.deckCount   = shoe.getDeckCount();
+    st.penetration = shoe.getPenetration();
+    st.cards       = shoe.GetCards();
+    st.dealt       = shoe.getDealtCount();
+    st.shuffles    = shoe.getShuffleCount();
+    shoe.GetEngine().getState(st.engine);
+    return st;
+}
+
+void BJRestoreShoe(BJShoe& shoe, const BJShoeState& st)
+{
+    if (st.deckCount != shoe.getDeckCount() || st.penetration != shoe.getPenetration())
+        throw std::invalid_argument("Saved shoe has another deck count or penetration");
+
+    shoe.restore(st.cards, st.dealt, st.shuffles);
+    shoe.GetEngine().setState(st.engine);
+}
+
+void BJEncodeShoe(std::vector<std::uint8_t>& out, const BJShoeState& st)
+{
+    std::uint64_t pen;
+    std::memcpy(&pen, &st.penetration, sizeof pen);
+
+    PutLE(out, (std::uint64_t)st.deckCount, 1);
+    PutLE(out, pen, 8);
+    PutLE(out, (std::uint64_t)st.dealt, 2);
+    PutLE(out, (std::uint64_t)st.shuffles, 4);
+    for (std::uint64_t w : st.engine)
+        PutLE(out, w, 8);
+    PutLE(out, st.cards.size(), 2);
+    for (const auto& c : st.cards)
+        out.push_back(c.getCode());
+}
+
+BJShoeState BJDecodeShoe(const std::uint8_t*& pos, const std::uint8_t* end)
+{
+    BJShoeState st;
+    st.deckCount = (int)GetLE(pos, end, 1);
+
+    const std::uint64_t pen = GetLE(pos, end, 8);
+    std::memcpy(&st.penetration, &pen, sizeof pen);
+
+    st.dealt    = (int)GetLE(pos, end, 2);
+    st.shuffles = (int)GetLE(pos, end, 4);
+    for (std::uint64_t& w : st.engine)
+        w = GetLE(pos, end, 8);
+
+    const std::size_t n = (std::size_t)GetLE(pos, end, 2);
+    if ((std::size_t)(end - pos) < n)
+        throw std::runtime_error("Saved state truncated");
+    st.cards.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        st.cards.push_back(BJCard::fromCode(*pos++));
+    return st;
+}
+
+// ---------------- SESSION SNAPSHOT ----------------
+
+BJGameSnapshot BJTakeSnapshot(const BJGame& g, BJSnapshotPoint at)
+{
+    BJGameSnapshot s;
+    s.seats.resize(g.getPlayerCount());
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        const BJPlayer& p = g.GetPlayer(i);
+        s.seats[i].chips    = p.getChips();
+        s.seats[i].bankrupt = p.isBankrupt();
+        // bets left the stack when placed (doubles and splits included)
+        if (at != BJSnapshotPoint::BetweenRounds)
+            s.seats[i].chips += p.getBet() + p.getSplitBet();
+    }
+    s.shoe      = BJCaptureShoe(g.GetShoe());
+    s.voidRound = at == BJSnapshotPoint::MidRound;
+    return s;
+}
+
+bool BJRestoreSnapshot(BJGame& g, const BJGameSnapshot& s)
+{
+    if ((int)s.seats.size() != g.getPlayerCount())
+        return false;
+
+    BJShoe& shoe = g.GetShoe();
+    if (s.shoe.deckCount == shoe.getDeckCount() && s.shoe.penetration == shoe.getPenetration()) {
+        BJRestoreShoe(shoe, s.shoe);
+        if (s.voidRound)
+            shoe.reshuffle();
+    }
+
+    g.resetForNextRound();
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        BJPlayer& p = g.GetPlayer(i);
+        p.adjustChips(s.seats[i].chips - p.getChips());
+        p.setBankrupt(s.seats[i].bankrupt);
+        p.setBet(0);
+        p.setSplitBet(0);
+    }
+    return true;
+}
+
+void BJWriteSnapshot(std::ostream& out, const BJGameSnapshot& s)
+{
+    std::vector<std::uint8_t> b(BJSnapshotMagic, BJSnapshotMagic + 4);
+    b.push_back(BJSnapshotVersion);
+    b.push_back((std::uint8_t)s.seats.size());
+    for (const auto& seat : s.seats) {
+        PutLE(b, (std::uint32_t)seat.chips, 4);
+        b.push_back(seat.bankrupt ? 1 : 0);
+    }
+    b.push_back(s.voidRound ? 1 : 0);
+    BJEncodeShoe(b, s.shoe);
+    PutLE(b, Fnv1a(b.data(), b.size()), 4);
+
+    out.write((const char*)b.data(), (std::streamsize)b.size());
+    if (!out)
+        throw std::runtime_error("Could not write snapshot");
+}
+
+BJGameSnapshot BJReadSnapshot(std::istream& in)
+{
+    const std::vector<std::uint8_t> b((std::istreambuf_iterator<char>(in)),
+                                      std::istreambuf_iterator<char>());
+    if (b.size() < 10 || std::memcmp(b.data(), BJSnapshotMagic, 4) != 0)
+        throw std::runtime_error("Not a snapshot");
+    if (b[4] != BJSnapshotVersion)
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(b[4]));
+
+    const std::uint8_t* end = b.data() + b.size() - 4;
+    const std::uint8_t* tail = end;
+    if (GetLE(tail, b.data() + b.size(), 4) != Fnv1a(b.data(), b.size() - 4))
+        throw std::runtime_error("Snapshot is damaged");
+
+    const std::uint8_t* pos = b.data() + 5;
+    BJGameSnapshot s;
+    s.seats.resize((std::size_t)GetLE(pos, end, 1));
+    for (auto& seat : s.seats) {
+        seat.chips    = (int)(std::uint32_t)GetLE(pos, end, 4);
+        seat.bankrupt = GetLE(pos, end, 1) != 0;
+    }
+    s.voidRound = GetLE(pos, end, 1) != 0;
+    s.shoe      = BJDecodeShoe(pos, end);
+    if (pos != end)
+        throw std::runtime_error("Snapshot is damaged");
+    return s;
+}
@@ -0,0 +1,81 @@
+//---------------------------------------------------------------------------
+#ifndef BJSnapshotH
+#define BJSnapshotH
+//---------------------------------------------------------------------------
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "BJGame.h"
+
+// ---------------- SHOE STATE ----------------
+
+// Everything a BJShoe needs to carry on dealing exactly where it stopped:
+// the card order, the dealt position, the shuffle count and the engine.
+struct BJShoeState {
+    int                 deckCount   = 1;
+    double              penetration = 0.75;
+    std::vector<BJCard> cards;
+    int                 dealt       = 0;
+    int                 shuffles    = 0;
+    std::uint64_t       engine[4]   = {};
+};
+
+BJShoeState BJCaptureShoe(const BJShoe& shoe);
+
+// Throws std::invalid_argument if the shoe has another deck count or
+// penetration, or the state does not hold its decks.
+void BJRestoreShoe(BJShoe& shoe, const BJShoeState& state);
+
+// Byte form shared by the snapshot and the round log: u8 decks, f64
+// penetration, u16 dealt, u32 shuffles, 4 x u64 engine, u16 card count and
+// the card codes, little endian. Decoding advances pos and throws
+// std::runtime_error if the bytes run out.
+void        BJEncodeShoe(std::vector<std::uint8_t>& out, const BJShoeState& state);
+BJShoeState BJDecodeShoe(const std::uint8_t*& pos, const std::uint8_t* end);
+
+// ---------------- SESSION SNAPSHOT ----------------
+
+// Where in a round a snapshot is taken. Only settled chips are kept: bets
+// still on the table go back to their seats, and a round that had dealt
+// cards is void, its shoe reshuffled on resume so nobody sees those cards
+// again.
+enum class BJSnapshotPoint : std::uint8_t {
+    BetweenRounds,      // bets settled, or none placed
+    Betting,            // bets placed, nothing dealt
+    MidRound            // cards out, not yet settled
+};
+
+// A table between rounds: every seat's chips and bankrupt flag and the
+// shoe. A few hundred bytes; restoring is a copy and a pass over the cards
+// already dealt.
+struct BJGameSnapshot {
+    struct Seat {
+        int  chips;
+        bool bankrupt;
+    };
+
+    std::vector<Seat> seats;
+    BJShoeState       shoe;
+    bool              voidRound = false;    // reshuffle on restore
+};
+
+BJGameSnapshot BJTakeSnapshot(const BJGame& g, BJSnapshotPoint at);
+
+// Seats the saved chips and flags on g with empty hands and no bets, and
+// puts the shoe back when g has the same decks and penetration (a table
+// set up differently keeps its fresh shoe). Returns false, changing
+// nothing, when the seat count differs; throws std::invalid_argument, also
+// before changing anything, when the saved shoe is not a set of its decks.
+bool BJRestoreSnapshot(BJGame& g, const BJGameSnapshot& s);
+
+// File form: "BJSS", u8 version, u8 seats, per seat i32 chips and u8
+// bankrupt, u8 void round, the shoe, then a u32 FNV-1a of everything
+// before it, so a write cut short is refused rather than half-restored.
+// Reading throws std::runtime_error on anything else.
+void           BJWriteSnapshot(std::ostream& out, const BJGameSnapshot& s);
+BJGameSnapshot BJReadSnapshot(std::istream& in);
+
+//---------------------------------------------------------------------------
+#endif
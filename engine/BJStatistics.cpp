@@ -0,0 +1,125 @@
+//---------------------------------------------------------------------------
+#include "BJStatistics.h"
+
+#include <cmath>
+//---------------------------------------------------------------------------
+
+// ---------------- STREAMING MOMENTS ----------------
+
+void BJMoments::merge(const BJMoments& o)
+{
+    if (o.n == 0)
+        return;
+    if (n == 0) {
+        *this = o;
+        return;
+    }
+
+    const double na = (double)n;
+    const double nb = (double)o.n;
+    const double nn = na + nb;
+
+    const double delta  = o.mean - mean;
+    const double delta2 = delta * delta;
+    const double delta3 = delta2 * delta;
+    const double delta4 = delta2 * delta2;
+
+    const double M2 = m2 + o.m2 + delta2 * na * nb / nn;
+
+    const double M3 = m3 + o.m3
+                    + delta3 * na * nb * (na - nb) / (nn * nn)
+                    + 3.0 * delta * (na * o.m2 - nb * m2) / nn;
+
+    const double M4 = m4 + o.m4
+                    + delta4 * na * nb * (na * na - na * nb + nb * nb) / (nn * nn * nn)
+                    + 6.0 * delta2 * (na * na * o.m2 + nb * nb * m2) / (nn * nn)
+                    + 4.0 * delta * (na * o.m3 - nb * m3) / nn;
+
+    n    += o.n;
+    mean += delta * nb / nn;
+    m2    = M2;
+    m3    = M3;
+    m4    = M4;
+}
+
+double BJMoments::stdDev() const
+{
+    return std::sqrt(variance());
+}
+
+double BJMoments::skewness() const
+{
+    if (n < 3 || m2 <= 0.0)
+        return 0.0;
+    return std::sqrt((double)n) * m3 / std::pow(m2, 1.5);
+}
+
+double BJMoments::kurtosis() const
+{
+    if (n < 4 || m2 <= 0.0)
+        return 0.0;
+    return (double)n * m4 / (m2 * m2) - 3.0;
+}
+
+double BJMoments::standardError() const
+{
+    return n ? std::sqrt(variance() / (double)n) : 0.0;
+}
+
+BJInterval BJMoments::confidenceInterval(double z) const
+{
+    const double h = z * standardError();
+    return { mean - h, mean + h };
+}
+
+// ---------------- ROUND STATISTICS ----------------
+
+void BJRoundStats::addSeat(double x, int upcard, int firstAction)
+{
+    net.add(x);
+    netByUpcard[upcard].add(x);
+    netByAction[firstAction].add(x);
+
+    int tenths = (int)std::lround(x * 10.0);
+    if (tenths < -BJNetTenthsMax) tenths = -BJNetTenthsMax;
+    if (tenths >  BJNetTenthsMax) tenths =  BJNetTenthsMax;
+    ++netCounts[tenths + BJNetTenthsMax];
+
+    if (x > 0.0)      ++wins;
+    else if (x < 0.0) ++losses;
+    else              ++pushes;
+}
+
+void BJRoundStats::merge(const BJRoundStats& o)
+{
+    rounds += o.rounds;
+    for (int a = 0; a < BJActionCount; ++a)
+        actions[a] += o.actions[a];
+
+    net.merge(o.net);
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        netCounts[i] += o.netCounts[i];
+    wins   += o.wins;
+    pushes += o.pushes;
+    losses += o.losses;
+
+    for (int u = 0; u < 11; ++u)
+        netByUpcard[u].merge(o.netByUpcard[u]);
+    for (int a = 0; a < BJFirstActionSlots; ++a)
+        netByAction[a].merge(o.netByAction[a]);
+
+    for (int t = 0; t < BJTotalSlots; ++t) {
+        playerTotals[t] += o.playerTotals[t];
+        dealerTotals[t] += o.dealerTotals[t];
+    }
+}
+
+BJRoundDistribution BJRoundStats::distribution() const
+{
+    BJRoundDistribution d;
+    if (net.n == 0)
+        return d;
+    for (int i = 0; i < BJNetOutcomes; ++i)
+        d.p[i] = (double)netCounts[i] / (double)net.n;
+    return d;
+}
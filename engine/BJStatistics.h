@@ -0,0 +1,311 @@
+//---------------------------------------------------------------------------
+#ifndef BJStatisticsH
+#define BJStatisticsH
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BJDecisionManager.h"
+#include "BJGoalOdds.h"
+#include "BJRound.h"
+#include "BJSimulator.h"
+
+// ---------------- STREAMING MOMENTS ----------------
+
+struct BJInterval {
+    double lo;
+    double hi;
+};
+
+// Count, mean and central moments up to the fourth, updated one value at a
+// time (Welford) and combined pairwise (Chan et al.). Merging two
+// accumulators gives the moments of the concatenated streams, without
+// the cancellation a sum of squares suffers on long runs.
+struct BJMoments {
+    std::uint64_t n    = 0;
+    double        mean = 0.0;
+    double        m2   = 0.0;
+    double        m3   = 0.0;
+    double        m4   = 0.0;
+
+    void add(double x) {
+        const double n1     = (double)n;
+        ++n;
+        const double nn     = (double)n;
+        const double delta  = x - mean;
+        const double dn     = delta / nn;
+        const double dn2    = dn * dn;
+        const double term1  = delta * dn * n1;
+
+        mean += dn;
+        m4   += term1 * dn2 * (nn * nn - 3.0 * nn + 3.0) + 6.0 * dn2 * m2 - 4.0 * dn * m3;
+        m3   += term1 * dn * (nn - 2.0) - 3.0 * dn * m2;
+        m2   += term1;
+    }
+
+    void merge(const BJMoments& o);
+
+    double variance() const { return n > 1 ? m2 / (double)(n - 1) : 0.0; }
+    double stdDev()   const;
+
+    double skewness() const;          // 0 below three values
+    double kurtosis() const;          // excess; 0 below four values
+
+    double standardError() const;
+
+    // mean +/- z standard errors; 1.96 is the 95% interval.
+    BJInterval confidenceInterval(double z = 1.96) const;
+};
+
+// ---------------- ROUND STATISTICS ----------------
+
+// Where a finished hand ended: its total (4-21), or one of these.
+enum {
+    BJTotalBust = 22,
+    BJTotalBlackjack,
+    BJTotalSurrendered,
+    BJTotalSlots
+};
+
+inline int BJTotalSlot(const BJHand& h, bool natural)
+{
+    if (h.getStatus() == BJHandStatus::Surrendered) return BJTotalSurrendered;
+    if (natural)                                    return BJTotalBlackjack;
+    if (h.isBust())                                 return BJTotalBust;
+    return h.value();
+}
+
+// Seats that never decided (a natural, or the dealer's) are filed under
+// this first action.
+constexpr int BJNoAction         = BJActionCount;
+constexpr int BJFirstActionSlots = BJActionCount + 1;
+
+// Per-seat-round results, in base-bet units, with the breakdowns the
+// simulator reports. Each table fills its own copy with no sharing; copies
+// merge exactly, in any grouping.
+struct BJRoundStats {
+    std::uint64_t rounds = 0;
+    std::uint64_t actions[BJActionCount] = {};
+
+    BJMoments     net;
+    std::uint64_t netCounts[BJNetOutcomes] = {};     // tenths + BJNetTenthsMax
+    std::uint64_t wins = 0, pushes = 0, losses = 0;
+
+    // by dealer upcard class (1 = ace .. 10)
+    BJMoments     netByUpcard[11];
+    // by the seat's first decision, BJNoAction when it had none
+    BJMoments     netByAction[BJFirstActionSlots];
+
+    std::uint64_t playerTotals[BJTotalSlots] = {};   // every hand, splits included
+    std::uint64_t dealerTotals[BJTotalSlots] = {};   // once per round
+
+    double        seconds = 0.0;
+
+    void addSeat(double net, int upcard, int firstAction);
+    void merge(const BJRoundStats& o);
+
+    BJRoundDistribution distribution() const;
+};
+
+// ---------------- TABLE LOOP ----------------
+
+// Wraps a strategy to note each seat's first decision of the round, as
+// BJPlayRound will play it (an action the rules refuse becomes a hit).
+template <class Strategy>
+struct BJFirstActionTap {
+    Strategy&         inner;
+    std::vector<int>& first;
+
+    template <class Game>
+    BJAction decide(const Game& g, const BJPlayer& p, const BJHand& h) {
+        BJAction a = inner.decide(g, p, h);
+
+        int& slot = first[g.getCurrentPlayerIndex()];
+        if (slot == BJNoAction) {
+            if ((a == BJAction::Double    && !BJDecisionManager::canDoubleDown(p, g)) ||
+                (a == BJAction::Split     && !BJDecisionManager::canSplit(p, g)) ||
+                (a == BJAction::Surrender && !BJDecisionManager::canSurrender(p, g)))
+            {
+                slot = (int)BJAction::Hit;
+            } else {
+                slot = (int)a;
+            }
+        }
+        return a;
+    }
+};
+
+// BJSimulateTable with the full breakdown. afterRound(played, stats) runs
+// after every round; the checkpointing runner uses it to publish copies.
+template <class Rules, class Strategy, class Engine, class AfterRound>
+void BJSimulateStatsTable(const BJSimConfig& cfg, const Engine& engine, std::uint64_t rounds,
+                          Strategy strategy, BJRoundStats& stats, AfterRound afterRound)
+{
+    const int bankroll = cfg.baseBet * 1000;
+
+    BJBasicGame<Rules, Engine> game(cfg.players, bankroll, cfg.deckCount, cfg.penetration);
+    game.GetShoe().setEngine(engine);
+
+    const double unit = 1.0 / (double)cfg.baseBet;
+
+    std::vector<int> first(cfg.players);
+    BJFirstActionTap<Strategy> tap{ strategy, first };
+
+    for (std::uint64_t r = 0; r < rounds; ++r) {
+        if (game.GetShoe().needsReshuffle())
+            game.GetShoe().reshuffle();
+
+        for (int i = 0; i < cfg.players; ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(bankroll - cfg.baseBet - p.getChips());
+            p.setBet(cfg.baseBet);
+            p.setSplitBet(0);
+            first[i] = BJNoAction;
+        }
+
+        BJPlayRound(game, tap, stats.actions);
+
+        const BJHand& dh = game.GetDealer().GetHand();
+        const int upcard = dh.GetCards()[0].getPoints();
+        ++stats.dealerTotals[BJTotalSlot(dh, dh.isBlackjack())];
+
+        for (int i = 0; i < cfg.players; ++i) {
+            const BJPlayer& p = game.GetPlayer(i);
+            stats.addSeat((double)(p.getChips() - bankroll) * unit, upcard, first[i]);
+
+            ++stats.playerTotals[BJTotalSlot(p.GetHand(), !p.hasSplitHand() && p.GetHand().isBlackjack())];
+            if (p.hasSplitHand())
+                ++stats.playerTotals[BJTotalSlot(p.GetSplitHand(), false)];
+        }
+        ++stats.rounds;
+
+        afterRound(r + 1, stats);
+    }
+}
+
+// ---------------- CHECKPOINTS ----------------
+
+// Write-once snapshot slots, one per table and checkpoint. A worker fills
+// its own slot and then bumps its table's published count (release); the
+// reader merges a checkpoint once every table has published it (acquire).
+// Nothing is ever written twice or shared between workers, so neither side
+// takes a lock.
+template <class Stats>
+class BJCheckpointSlots {
+private:
+    int                                  tables;
+    int                                  checkpoints;
+    std::vector<Stats>                   slots;
+    std::unique_ptr<std::atomic<int>[]>  published;
+
+public:
+    BJCheckpointSlots(int table_count, int checkpoint_count)
+        : tables(table_count), checkpoints(checkpoint_count),
+          slots((std::size_t)table_count * (std::size_t)checkpoint_count),
+          published(new std::atomic<int>[table_count])
+    {
+        for (int t = 0; t < tables; ++t)
+            published[t].store(0, std::memory_order_relaxed);
+    }
+
+    // Called by table t's worker, for c = 0, 1, ... in order.
+    void publish(int t, int c, const Stats& s) {
+        slots[(std::size_t)t * checkpoints + c] = s;
+        published[t].store(c + 1, std::memory_order_release);
+    }
+
+    bool ready(int c) const {
+        for (int t = 0; t < tables; ++t)
+            if (published[t].load(std::memory_order_acquire) <= c)
+                return false;
+        return true;
+    }
+
+    // Merged in table order, so a checkpoint is as reproducible as the
+    // final result.
+    Stats merged(int c) const {
+        Stats total;
+        for (int t = 0; t < tables; ++t)
+            total.merge(slots[(std::size_t)t * checkpoints + c]);
+        return total;
+    }
+};
+
+// BJSimulate with the full breakdown. With checkpoints > 0, every table
+// also publishes its running totals at checkpoints evenly spaced points
+// through its share, and onCheckpoint(c, merged) is called on the calling
+// thread as each one completes across all tables, while the run goes on.
+template <class Rules, class Strategy, class OnCheckpoint>
+BJRoundStats BJSimulateDetailed(const BJSimConfig& cfg, const Strategy& strategy,
+                                int checkpoints, OnCheckpoint onCheckpoint)
+{
+    typedef BJXoshiro256ss Engine;
+
+    if (checkpoints < 0)
+        checkpoints = 0;
+
+    const int tables = cfg.tables > 0 ? cfg.tables : 1;
+    BJCheckpointSlots<BJRoundStats> slots(tables, checkpoints);
+
+    // the tables run off this thread so the checkpoints can be reported as
+    // they come; an exception on either side is held until run is joined
+    BJRoundStats       total;
+    std::exception_ptr runError, checkpointError;
+    std::atomic<bool>  done(false);
+    std::thread run([&]() {
+        try {
+            total = BJRunTables<Engine, BJRoundStats>(cfg,
+                [&](int t, const Engine& engine, std::uint64_t rounds, BJRoundStats& stats) {
+                    int next = 0;
+                    auto due = [&](std::uint64_t played) {
+                        return next < checkpoints &&
+                               played >= rounds * (std::uint64_t)(next + 1) / (std::uint64_t)(checkpoints + 1);
+                    };
+                    BJSimulateStatsTable<Rules>(cfg, engine, rounds, strategy, stats,
+                        [&](std::uint64_t played, const BJRoundStats& s) {
+                            while (due(played))
+                                slots.publish(t, next++, s);
+                        });
+                    while (next < checkpoints)
+                        slots.publish(t, next++, stats);
+                });
+        } catch (...) {
+            runError = std::current_exception();
+        }
+        done = true;
+    });
+
+    try {
+        for (int c = 0; c < checkpoints; ++c) {
+            while (!slots.ready(c) && !done)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (!slots.ready(c))
+                break;                  // the run failed short of it
+            onCheckpoint(c, slots.merged(c));
+        }
+    } catch (...) {
+        checkpointError = std::current_exception();
+    }
+
+    run.join();
+    if (runError)
+        std::rethrow_exception(runError);
+    if (checkpointError)
+        std::rethrow_exception(checkpointError);
+    return total;
+}
+
+template <class Rules, class Strategy>
+BJRoundStats BJSimulateDetailed(const BJSimConfig& cfg, const Strategy& strategy)
+{
+    return BJSimulateDetailed<Rules>(cfg, strategy, 0, [](int, const BJRoundStats&) {});
+}
+
+//---------------------------------------------------------------------------
+#endif
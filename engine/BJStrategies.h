@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------
+#ifndef BJStrategiesH
+#define BJStrategiesH
+//---------------------------------------------------------------------------
+
+#include "BJBasicStrategyH17.h"
+#include "BJBasicStrategyS17.h"
+#include "BJDecisionManager.h"
+#include "BJExpectedValue.h"
+#include "BJRound.h"
+
+// ---------------- SIMPLE STRATEGIES ----------------
+
+// Plays the dealer's rule: hit below 17, stand otherwise.
+struct BJMimicDealerStrategy {
+    template <class Game>
+    BJAction decide(const Game&, const BJPlayer&, const BJHand& h) const {
+        return h.value() < 17 ? BJAction::Hit : BJAction::Stand;
+    }
+};
+
+// Never risks a bust: hits hard totals only while no card can take the hand
+// over 21, and soft totals up to 17.
+struct BJNeverBustStrategy {
+    template <class Game>
+    BJAction decide(const Game&, const BJPlayer&, const BJHand& h) const {
+        return h.value() <= (h.isSoft() ? 17 : 11) ? BJAction::Hit : BJAction::Stand;
+    }
+};
+
+// ---------------- BASIC STRATEGY ----------------
+
+// Plays a generated BJStrategyTable (see tools/bjstrategy), taking the
+// fallback action whenever a double, split or surrender is not allowed.
+class BJBasicStrategy {
+private:
+    const BJStrategyTable* table;
+
+public:
+    explicit BJBasicStrategy(const BJStrategyTable& t = BJBasicStrategyS17) : table(&t) {}
+
+    const BJStrategyTable& GetTable() const { return *table; }
+
+    template <class Game>
+    BJAction decide(const Game& g, const BJPlayer& p, const BJHand& h) const {
+        const int upcard = g.GetDealer().GetHand().GetCards()[0].getPoints();
+
+        switch (table->lookup(h, upcard, BJDecisionManager::canSplit(p, g))) {
+            case BJCodeHit:
+                return BJAction::Hit;
+            case BJCodeSplit:
+                return BJAction::Split;
+            case BJCodeDoubleHit:
+                return BJDecisionManager::canDoubleDown(p, g) ? BJAction::Double : BJAction::Hit;
+            case BJCodeDoubleStand:
+                return BJDecisionManager::canDoubleDown(p, g) ? BJAction::Double : BJAction::Stand;
+            case BJCodeSurrenderHit:
+                return BJDecisionManager::canSurrender(p, g) ? BJAction::Surrender : BJAction::Hit;
+            case BJCodeSurrenderStand:
+                return BJDecisionManager::canSurrender(p, g) ? BJAction::Surrender : BJAction::Stand;
+            case BJCodeSurrenderSplit:
+                return BJDecisionManager::canSurrender(p, g) ? BJAction::Surrender : BJAction::Split;
+            default:
+                return BJAction::Stand;
+        }
+    }
+};
+
+// ---------------- COMPOSITION-DEPENDENT STRATEGY ----------------
+
+// Takes the best legal action for the exact cards left in the shoe, asking
+// a BJEVFast solver on every decision. Each copy owns its solver, so give
+// each table its own copy.
+class BJCompositionStrategy {
+private:
+    BJEVSolver solver;
+
+public:
+    template <class Rules>
+    explicit BJCompositionStrategy(const Rules& rules) : solver(rules, BJEVFast) {}
+
+    template <class Game>
+    BJAction decide(const Game& g, const BJPlayer&, const BJHand&) {
+        return BJEvaluateCurrentHand(solver, g).best();
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,179 @@
+//---------------------------------------------------------------------------
+#include "BJStrategyGenerator.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "BJBasicStrategyApp.h"
+#include "BJBasicStrategyH17.h"
+#include "BJBasicStrategyS17.h"
+#include "BJComposition.h"
+#include "BJExpectedValue.h"
+//---------------------------------------------------------------------------
+
+enum BJTableKind { BJKindHard, BJKindSoft, BJKindPair, BJKindCount };
+
+static char CodeFor(const BJHandEV& e, bool allowSplit)
+{
+    BJHandEV v = e;
+    if (!allowSplit)
+        v.ev[(int)BJAction::Split] = BJEVNotAllowed;
+
+    const bool hitFallback = (v.bestHitStand() == BJAction::Hit);
+    const bool splitFallback = allowSplit
+                            && v.of(BJAction::Split) > v.of(v.bestHitStand())
+                            && v.of(BJAction::Split) > v.of(BJAction::Double);
+    switch (v.best()) {
+        case BJAction::Hit:       return BJCodeHit;
+        case BJAction::Double:    return hitFallback ? BJCodeDoubleHit : BJCodeDoubleStand;
+        case BJAction::Split:     return BJCodeSplit;
+        case BJAction::Surrender:
+            if (splitFallback)
+                return BJCodeSurrenderSplit;
+            return hitFallback ? BJCodeSurrenderHit : BJCodeSurrenderStand;
+        default:                  return BJCodeStand;
+    }
+}
+
+// Average EVs of every non-ace two-card hand with this hard total.
+static bool HardTotalEV(BJEVSolver& solver, int total, int upcard,
+                        const BJShoeComposition& shoe, BJHandEV& out)
+{
+    double weightSum = 0.0;
+    for (int a = 0; a < BJActionCount; ++a)
+        out.ev[a] = 0.0;
+
+    const double n = (double)shoe.size();
+    for (int c1 = 2; c1 <= 10; ++c1) {
+        const int c2 = total - c1;
+        if (c2 < c1 || c2 > 10)
+            continue;
+
+        const int n1 = shoe.count(c1);
+        const int n2 = shoe.count(c2) - (c1 == c2 ? 1 : 0);
+        if (n1 <= 0 || n2 <= 0)
+            continue;
+        const double w = (double)n1 / n * (double)n2 / (n - 1.0) * (c1 == c2 ? 1.0 : 2.0);
+
+        BJShoeComposition rest = shoe;
+        rest.remove(c1);
+        rest.remove(c2);
+        const BJHandEV e = solver.evaluate(c1, c2, upcard, rest);
+        for (int a = 0; a < BJActionCount; ++a)
+            out.ev[a] += w * e.ev[a];
+        weightSum += w;
+    }
+
+    if (weightSum == 0.0)
+        return false;
+    for (int a = 0; a < BJActionCount; ++a)
+        out.ev[a] /= weightSum;
+    return true;
+}
+
+static BJHandEV PairEV(BJEVSolver& solver, int c1, int c2, int upcard, const BJShoeComposition& shoe)
+{
+    BJShoeComposition rest = shoe;
+    rest.remove(c1);
+    rest.remove(c2);
+    return solver.evaluate(c1, c2, upcard, rest);
+}
+
+static void FillRow(char* row, char code)
+{
+    std::memset(row, code, BJStrategyColumns);
+    row[BJStrategyColumns] = '\0';
+}
+
+BJStrategyTable BJGenerateStrategyTable(const BJRuntimeRules& rules, int deckCount, unsigned threads)
+{
+    BJStrategyTable table;
+    for (int v = 0; v < 22; ++v) {
+        FillRow(table.hard[v], v == 21 ? BJCodeStand : BJCodeHit);
+        FillRow(table.soft[v], v == 21 ? BJCodeStand : BJCodeHit);
+    }
+    for (int c = 0; c < 11; ++c)
+        FillRow(table.pair[c], BJCodeHit);
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    // One work unit per (row kind, upcard); each worker keeps its own solver
+    // so memo tables are never shared. Every unit writes distinct cells.
+    const int units = BJKindCount * 10;
+    std::atomic<int> nextUnit(0);
+
+    auto worker = [&]() {
+        BJEVSolver solver(rules);
+        for (;;) {
+            const int unit = nextUnit.fetch_add(1);
+            if (unit >= units)
+                break;
+            const int kind   = unit / 10;
+            const int upcard = unit % 10 + 1;
+            const int col    = BJStrategyTable::column(upcard);
+
+            BJShoeComposition shoe = BJShoeComposition::full(deckCount);
+            shoe.remove(upcard);
+
+            if (kind == BJKindHard) {
+                for (int total = 4; total <= 20; ++total) {
+                    BJHandEV e;
+                    if (HardTotalEV(solver, total, upcard, shoe, e))
+                        table.hard[total][col] = CodeFor(e, false);
+                }
+            } else if (kind == BJKindSoft) {
+                for (int total = 12; total <= 20; ++total)
+                    table.soft[total][col] = CodeFor(PairEV(solver, 1, total - 11, upcard, shoe), false);
+            } else {
+                for (int c = 1; c <= 10; ++c)
+                    table.pair[c][col] = CodeFor(PairEV(solver, c, c, upcard, shoe), true);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool)
+        t.join();
+
+    return table;
+}
+
+BJStrategyTable BJBasicStrategyFor(const BJRuntimeRules& rules, int deckCount, unsigned threads)
+{
+    if (deckCount == 6 && rules == BJRuntimeRules::from(BJRulesS17()))
+        return BJBasicStrategyS17;
+    if (deckCount == 6 && rules == BJRuntimeRules::from(BJRulesH17()))
+        return BJBasicStrategyH17;
+    if (deckCount == 6 && rules == BJRuntimeRules())
+        return BJBasicStrategyApp;
+    return BJGenerateStrategyTable(rules, deckCount, threads);
+}
+
+static void WriteRows(std::ostream& out, const char (*rows)[BJStrategyColumns + 1], int count,
+                      const char* label)
+{
+    out << "    {   // " << label << "\n";
+    out << "        // 23456789TA\n";
+    for (int r = 0; r < count; ++r)
+        out << "        \"" << rows[r] << "\",   // " << r << "\n";
+    out << "    },\n";
+}
+
+void BJWriteStrategyTable(std::ostream& out, const BJStrategyTable& table,
+                          const std::string& name, const std::string& comment)
+{
+    out << "// " << comment << "\n";
+    out << "inline constexpr BJStrategyTable " << name << " = {\n";
+    WriteRows(out, table.hard, 22, "hard");
+    WriteRows(out, table.soft, 22, "soft");
+    WriteRows(out, table.pair, 11, "pair");
+    out << "};\n";
+}
@@ -0,0 +1,31 @@
+//---------------------------------------------------------------------------
+#ifndef BJStrategyGeneratorH
+#define BJStrategyGeneratorH
+//---------------------------------------------------------------------------
+
+#include <ostream>
+#include <string>
+
+#include "BJStrategyTable.h"
+#include "BJRules.h"
+
+// ---------------- BASIC STRATEGY GENERATOR ----------------
+
+// Builds the total-dependent basic strategy for a rule set and deck count.
+// Each hard/soft cell averages the exact EVs of every two-card hand making
+// that total, weighted by how often it is dealt; pair cells use the pair
+// itself. Cells are spread over `threads` workers (0 = hardware threads).
+BJStrategyTable BJGenerateStrategyTable(const BJRuntimeRules& rules, int deckCount,
+                                        unsigned threads = 0);
+
+// The shipped 6-deck table when the rules match one (S17, H17 or the app's
+// defaults), otherwise a freshly generated table.
+BJStrategyTable BJBasicStrategyFor(const BJRuntimeRules& rules, int deckCount,
+                                   unsigned threads = 0);
+
+// Writes the table as a constexpr C++ definition named `name`.
+void BJWriteStrategyTable(std::ostream& out, const BJStrategyTable& table,
+                          const std::string& name, const std::string& comment);
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,50 @@
+//---------------------------------------------------------------------------
+#ifndef BJStrategyTableH
+#define BJStrategyTableH
+//---------------------------------------------------------------------------
+
+#include "BJHand.h"
+
+// ---------------- STRATEGY TABLE ----------------
+
+// One letter per cell, as on a printed chart:
+//   S stand, H hit, P split,
+//   D double (else hit),     d double (else stand),
+//   R surrender (else hit),  r surrender (else stand),
+//   Q surrender (else split; pair rows only).
+constexpr char BJCodeStand          = 'S';
+constexpr char BJCodeHit            = 'H';
+constexpr char BJCodeSplit          = 'P';
+constexpr char BJCodeDoubleHit      = 'D';
+constexpr char BJCodeDoubleStand    = 'd';
+constexpr char BJCodeSurrenderHit   = 'R';
+constexpr char BJCodeSurrenderStand = 'r';
+constexpr char BJCodeSurrenderSplit = 'Q';
+
+// Columns run 2..10 then ace; rows are indexed by hard total, soft total
+// or pair rank class (ace = 1). Unused rows are filled with H or S.
+constexpr int BJStrategyColumns = 10;
+
+struct BJStrategyTable {
+    char hard[22][BJStrategyColumns + 1];
+    char soft[22][BJStrategyColumns + 1];
+    char pair[11][BJStrategyColumns + 1];
+
+    static constexpr int column(int upcard) { return upcard == 1 ? 9 : upcard - 2; }
+
+    // Code for a hand against the dealer's upcard (rank class). The pair row
+    // is consulted only when the hand may be split.
+    char lookup(const BJHand& h, int upcard, bool splittable) const {
+        const int col = column(upcard);
+        if (splittable) {
+            const char code = pair[h.GetCards()[0].getPoints()][col];
+            if (code == BJCodeSplit || code == BJCodeSurrenderSplit)
+                return code;
+        }
+        const int v = h.value();
+        return h.isSoft() ? soft[v][col] : hard[v][col];
+    }
+};
+
+//---------------------------------------------------------------------------
+#endif
@@ -0,0 +1,149 @@
+//---------------------------------------------------------------------------
+// bjbots: unattended bot sessions on the app's game, for soak tests and
+// profiling load.
+//
+//   bjbots [--seats basic,counting,random,flat] [--chips N] [--goal N]
+//          [--bet N] [--decks D] [--penetration F] [--rules s17|h17|app]
+//          [--rounds N] [--sessions N] [--seed S]
+//
+// Each session plays until a seat reaches the goal, every seat is broke or
+// --rounds rounds have been played. Session k shuffles from --seed + k.
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BJBots.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjbots [--seats basic,counting,random,flat] [--chips N] [--goal N]\n"
+                "              [--bet N] [--decks D] [--penetration F] [--rules s17|h17|app]\n"
+                "              [--rounds N] [--sessions N] [--seed S]\n");
+}
+
+static bool ParseSeats(const std::string& list, std::vector<BJBotKind>& out)
+{
+    out.clear();
+    std::size_t start = 0;
+    for (;;) {
+        const std::size_t comma = list.find(',', start);
+        BJBotKind k;
+        if (!BJParseBotKind(list.substr(start, comma - start), k) || k == BJBotKind::Human)
+            return false;
+        out.push_back(k);
+        if (comma == std::string::npos)
+            break;
+        start = comma + 1;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string   seatList    = "basic,counting,random,flat";
+    int           chips       = 500;
+    int           goal        = 1000;
+    int           bet         = 10;
+    int           decks       = 6;
+    double        penetration = 0.75;
+    std::string   rules       = "app";
+    std::uint64_t rounds      = 1000000;
+    std::uint64_t sessions    = 1;
+    std::uint64_t seed        = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--seats"))       seatList    = val;
+        else if (!std::strcmp(arg, "--chips"))       chips       = std::atoi(val);
+        else if (!std::strcmp(arg, "--goal"))        goal        = std::atoi(val);
+        else if (!std::strcmp(arg, "--bet"))         bet         = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))       decks       = std::atoi(val);
+        else if (!std::strcmp(arg, "--penetration")) penetration = std::atof(val);
+        else if (!std::strcmp(arg, "--rules"))       rules       = val;
+        else if (!std::strcmp(arg, "--rounds"))      rounds      = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--sessions"))    sessions    = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--seed"))        seed        = std::strtoull(val, nullptr, 10);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    std::vector<BJBotKind> kinds;
+    if (!ParseSeats(seatList, kinds)) {
+        PrintUsage();
+        return 1;
+    }
+
+    BJRuntimeRules r;
+    if (rules == "s17")
+        r = BJRuntimeRules::from(BJRulesS17());
+    else if (rules == "h17")
+        r = BJRuntimeRules::from(BJRulesH17());
+    else if (rules != "app") {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        const int seatCount = (int)kinds.size();
+
+        std::uint64_t totalRounds = 0, goals = 0, busts = 0, capped = 0;
+        double        seconds = 0.0;
+        std::vector<long long> netChips(seatCount, 0);
+
+        for (std::uint64_t k = 0; k < sessions; ++k) {
+            std::vector<std::unique_ptr<BJSeatController>> bots;
+            std::vector<BJSeatController*> seats;
+            for (int i = 0; i < seatCount; ++i) {
+                bots.push_back(BJMakeBot(kinds[i], r, decks, bet, seed + k * seatCount + i));
+                seats.push_back(bots.back().get());
+            }
+
+            BJGame game(seatCount, chips, decks, penetration, r);
+            game.GetShoe().seed(seed + k);
+
+            const BJBotSession s = BJRunBotSession(game, seats, goal, rounds);
+            totalRounds += s.rounds;
+            seconds     += s.seconds;
+            if (s.goalReached)      ++goals;
+            else if (s.allBankrupt) ++busts;
+            else                    ++capped;
+
+            for (int i = 0; i < seatCount; ++i)
+                netChips[i] += game.GetPlayer(i).getChips() - chips;
+        }
+
+        std::printf("sessions        %llu: %llu reached %d, %llu all broke, %llu hit the round limit\n",
+                    (unsigned long long)sessions, (unsigned long long)goals, goal,
+                    (unsigned long long)busts, (unsigned long long)capped);
+        for (int i = 0; i < seatCount; ++i)
+            std::printf("  seat %d %-9s %+.1f chips a session\n", i + 1,
+                        BJBotKindName(kinds[i]), (double)netChips[i] / (double)sessions);
+        std::printf("rounds          %llu (%.1f a session)\n", (unsigned long long)totalRounds,
+                    (double)totalRounds / (double)sessions);
+        std::printf("elapsed         %.3f s\n", seconds);
+        std::printf("rounds/sec      %.0f\n", seconds > 0.0 ? (double)totalRounds / seconds : 0.0);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjbots: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------------
+// bjgoal: odds of reaching a chip goal before going broke.
+//
+//   bjgoal [--chips N] [--goal N] [--bet N] [--decks D] [--rules s17|h17|app]
+//          [--rounds N] [--paths N] [--threads T] [--seed S]
+//
+// Measures the basic-strategy round distribution, then reports the exact
+// first-passage odds, the diffusion approximation and, with --paths, a
+// Monte Carlo check over that many bankroll paths.
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "BJGoalOdds.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjgoal [--chips N] [--goal N] [--bet N] [--decks D] [--rules s17|h17|app]\n"
+                "              [--rounds N] [--paths N] [--threads T] [--seed S]\n");
+}
+
+int main(int argc, char** argv)
+{
+    double        chips   = 1000.0;
+    double        goal    = 2000.0;
+    double        bet     = 10.0;
+    int           decks   = 6;
+    std::string   rules   = "app";
+    std::uint64_t rounds  = 1000000;
+    std::uint64_t paths   = 0;
+    unsigned      threads = 0;
+    std::uint64_t seed    = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--chips"))   chips   = std::atof(val);
+        else if (!std::strcmp(arg, "--goal"))    goal    = std::atof(val);
+        else if (!std::strcmp(arg, "--bet"))     bet     = std::atof(val);
+        else if (!std::strcmp(arg, "--decks"))   decks   = std::atoi(val);
+        else if (!std::strcmp(arg, "--rules"))   rules   = val;
+        else if (!std::strcmp(arg, "--rounds"))  rounds  = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--paths"))   paths   = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--threads")) threads = (unsigned)std::atoi(val);
+        else if (!std::strcmp(arg, "--seed"))    seed    = std::strtoull(val, nullptr, 10);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    BJRuntimeRules r;
+    if (rules == "s17")
+        r = BJRuntimeRules::from(BJRulesS17());
+    else if (rules == "h17")
+        r = BJRuntimeRules::from(BJRulesH17());
+    else if (rules != "app") {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        const BJRoundDistribution d = BJBasicStrategyRounds(r, decks, rounds, seed);
+        std::printf("rounds          %llu, mean %+.4f, variance %.4f (per bet)\n",
+                    (unsigned long long)rounds, d.mean(), d.variance());
+        std::printf("bankroll        %.0f -> %.0f betting %.0f\n", chips, goal, bet);
+
+        try {
+            const BJGoalOdds exact = BJGoalOddsExact(d, chips, goal, bet);
+            std::printf("exact           %.4f%% (%.0f rounds expected)\n",
+                        100.0 * exact.reach, exact.expectedRounds);
+        } catch (const std::length_error& e) {
+            std::printf("exact           skipped: %s\n", e.what());
+        }
+        std::printf("diffusion       %.4f%%\n", 100.0 * BJGoalReachDiffusion(d, chips, goal, bet));
+
+        if (paths > 0) {
+            const BJGoalSample mc = BJGoalReachMonteCarlo(d, chips, goal, BJFlatChips{ bet },
+                                                          paths, seed, threads);
+            std::printf("monte carlo     %.4f%% +/- %.4f%% over %llu paths (%llu unfinished), %.3f s\n",
+                        100.0 * mc.probability(), 100.0 * mc.standardError(),
+                        (unsigned long long)mc.paths, (unsigned long long)mc.unfinished, mc.seconds);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjgoal: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
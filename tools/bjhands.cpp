@@ -0,0 +1,250 @@
+//---------------------------------------------------------------------------
+// bjhands: batched hand evaluation across many tables, at each SIMD level.
+//
+//   bjhands [--tables N] [--rounds R] [--decks D] [--seed S] [--h17]
+//
+// Every round, each table deals a player and a dealer two cards; players
+// then draw to 17, dealers play out and every hand is settled, all through
+// BJHandBatch. Each level plays the same cards, and its payouts are checked
+// against BJHand and BJSettleHands one table at a time.
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "BJHandBatch.h"
+#include "BJShoe.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjhands [--tables N] [--rounds R] [--decks D] [--seed S] [--h17]\n");
+}
+
+// Card points dealt in a fixed order: the k-th draw of the round goes to
+// table i from stream[(base + k * tables + i) % size].
+struct CardStream {
+    std::vector<std::uint8_t> points;
+
+    // size must be a power of two
+    CardStream(int decks, std::uint64_t seed, std::size_t size) {
+        BJShoe shoe(decks, 0.75, seed);
+        points.reserve(size);
+        while (points.size() < size) {
+            if (shoe.needsReshuffle())
+                shoe.reshuffle();
+            points.push_back((std::uint8_t)shoe.DrawCard().getPoints());
+        }
+    }
+
+    std::uint8_t at(std::size_t k) const { return points[k & (points.size() - 1)]; }
+};
+
+struct RunResult {
+    double        seconds = 0.0;
+    std::uint64_t updates = 0;      // hands touched by a bulk operation
+    long long     paid    = 0;
+    std::vector<std::int32_t> payouts;
+};
+
+// Draws to the mask: next[i] is the table's next card where mask[i] is
+// set. Returns whether any hand drew.
+static bool MaskedDraw(const CardStream& cards, std::size_t& pos, int tables,
+                       const std::uint8_t* mask, std::uint8_t* next)
+{
+    bool any = false;
+    for (int i = 0; i < tables; ++i) {
+        next[i] = mask[i] ? cards.at(pos + i) : 0;
+        any |= mask[i] != 0;
+    }
+    pos += tables;
+    return any;
+}
+
+static RunResult RunBatch(const CardStream& cards, int tables, int rounds, bool h17, BJSimdLevel level)
+{
+    BJHandBatch players(tables, level), dealers(tables, level);
+
+    std::vector<std::uint8_t> next(tables), mask(tables), status(tables), flags(tables),
+                              scores(tables), classes(tables);
+    std::vector<std::int32_t> bets(tables, 10);
+    std::vector<BJSettleResult> results(tables);
+
+    RunResult out;
+    out.payouts.resize((std::size_t)tables * rounds);
+
+    std::size_t pos = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int r = 0; r < rounds; ++r) {
+        players.clear();
+        dealers.clear();
+
+        for (int k = 0; k < 2; ++k) {
+            for (int i = 0; i < tables; ++i) next[i] = cards.at(pos + i);
+            pos += tables;
+            players.addCards(next.data());
+            for (int i = 0; i < tables; ++i) next[i] = cards.at(pos + i);
+            pos += tables;
+            dealers.addCards(next.data());
+            out.updates += 2 * (std::uint64_t)tables;
+        }
+
+        for (;;) {
+            players.dealerMustHit(false, mask.data());
+            out.updates += tables;
+            if (!MaskedDraw(cards, pos, tables, mask.data(), next.data()))
+                break;
+            players.addCards(next.data());
+            out.updates += tables;
+        }
+        for (;;) {
+            dealers.dealerMustHit(h17, mask.data());
+            out.updates += tables;
+            if (!MaskedDraw(cards, pos, tables, mask.data(), next.data()))
+                break;
+            dealers.addCards(next.data());
+            out.updates += tables;
+        }
+
+        players.status(status.data());
+        for (int i = 0; i < tables; ++i)
+            flags[i] = (status[i] & BJBatchBlackjack) ? BJSettleNatural : BJSettleNone;
+        dealers.dealerScores(scores.data());
+        players.classify(flags.data(), scores.data(), classes.data());
+        BJPayBatch(classes.data(), bets.data(), tables, BJPayout3to2, results.data());
+        out.updates += 3 * (std::uint64_t)tables;
+
+        for (int i = 0; i < tables; ++i) {
+            out.payouts[(std::size_t)r * tables + i] = results[i].payout;
+            out.paid += results[i].payout;
+        }
+    }
+
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
+// The same rounds one table at a time on BJHand, for checking.
+static std::vector<std::int32_t> RunReference(const CardStream& cards, int tables, int rounds, bool h17)
+{
+    std::vector<BJHand> players(tables), dealers(tables);
+    std::vector<std::uint8_t> mask(tables);
+    std::vector<std::int32_t> payouts((std::size_t)tables * rounds);
+
+    std::size_t pos = 0;
+    auto draw = [&](BJHand& h, std::uint8_t p) {
+        // any card of the right points will do
+        h.addCard(BJCard(BJSuit::SuitSpade, p == 1 ? BJRank::RA : (BJRank)p));
+    };
+
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < tables; ++i) {
+            players[i].clear();
+            dealers[i].clear();
+        }
+        for (int k = 0; k < 2; ++k) {
+            for (int i = 0; i < tables; ++i) draw(players[i], cards.at(pos + i));
+            pos += tables;
+            for (int i = 0; i < tables; ++i) draw(dealers[i], cards.at(pos + i));
+            pos += tables;
+        }
+
+        for (bool any = true; any; pos += tables) {
+            any = false;
+            for (int i = 0; i < tables; ++i) mask[i] = players[i].value() < 17;
+            for (int i = 0; i < tables; ++i) {
+                if (mask[i]) { draw(players[i], cards.at(pos + i)); any = true; }
+            }
+        }
+        for (bool any = true; any; pos += tables) {
+            any = false;
+            for (int i = 0; i < tables; ++i) {
+                const BJHand& d = dealers[i];
+                mask[i] = d.value() < 17 || (h17 && d.value() == 17 && d.isSoft());
+            }
+            for (int i = 0; i < tables; ++i) {
+                if (mask[i]) { draw(dealers[i], cards.at(pos + i)); any = true; }
+            }
+        }
+
+        for (int i = 0; i < tables; ++i) {
+            const BJSettleRecord rec = {
+                (std::uint8_t)players[i].value(),
+                (std::uint8_t)(players[i].isBlackjack() ? BJSettleNatural : BJSettleNone),
+                10
+            };
+            BJSettleResult res;
+            BJSettleHands(&rec, 1, dealers[i].value(), dealers[i].isBlackjack(), BJPayout3to2, &res);
+            payouts[(std::size_t)r * tables + i] = res.payout;
+        }
+    }
+    return payouts;
+}
+
+int main(int argc, char** argv)
+{
+    int           tables = 4096;
+    int           rounds = 2000;
+    int           decks  = 6;
+    std::uint64_t seed   = 1;
+    bool          h17    = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--h17")) {
+            h17 = true;
+            continue;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--tables")) tables = std::atoi(val);
+        else if (!std::strcmp(arg, "--rounds")) rounds = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))  decks  = std::atoi(val);
+        else if (!std::strcmp(arg, "--seed"))   seed   = std::strtoull(val, nullptr, 10);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (tables < 1 || rounds < 1) {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        const CardStream cards(decks, seed, 1u << 20);
+        const std::vector<std::int32_t> reference = RunReference(cards, tables, rounds, h17);
+
+        std::printf("tables          %d x %d rounds, best level %s\n",
+                    tables, rounds, BJSimdLevelName(BJBestSimdLevel()));
+
+        bool ok = true;
+        for (int l = 0; l <= (int)BJBestSimdLevel(); ++l) {
+            const RunResult r = RunBatch(cards, tables, rounds, h17, (BJSimdLevel)l);
+            const bool match = r.payouts == reference;
+            ok &= match;
+            std::printf("  %-8s      %.3f s, %.1f M hand updates/s, paid %lld, %s\n",
+                        BJSimdLevelName((BJSimdLevel)l), r.seconds,
+                        (double)r.updates / r.seconds / 1e6, r.paid,
+                        match ? "matches BJHand" : "MISMATCH");
+        }
+        return ok ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjhands: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,272 @@
+//---------------------------------------------------------------------------
+// bjhistory: writes and scans hand-history archives.
+//
+//   bjhistory --write FILE [--rounds N] [--players P] [--decks D]
+//             [--rules s17|h17|app] [--seed S] [--block KB]
+//             [--async] [--threads T]
+//   bjhistory --scan FILE [--dump N]
+//
+// --write plays N basic-strategy rounds and archives every one of them.
+// With --async the tables log events instead and a background thread
+// rebuilds and writes the rounds; --threads T plays on T tables at once,
+// table k on substream k of seed S as in bjsim, sharing the N rounds and
+// the one archive. One async table writes the same archive as the direct
+// writer.
+// --scan maps an archive, walks every round and reports the totals and the
+// scan speed; --dump N prints the first N rounds.
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BJEventLog.h"
+#include "BJHandHistory.h"
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjhistory --write FILE [--rounds N] [--players P] [--decks D]\n"
+                "                 [--rules s17|h17|app] [--seed S] [--block KB]\n"
+                "                 [--async] [--threads T]\n"
+                "       bjhistory --scan FILE [--dump N]\n");
+}
+
+static double Seconds(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+static std::string CardsText(const BJCard* cards, int n)
+{
+    std::string s;
+    for (int i = 0; i < n; ++i) {
+        if (i) s += ' ';
+        s += cards[i].getGlyph();
+    }
+    return s;
+}
+
+static void DumpRound(const BJHistoryRound& r)
+{
+    std::printf("round %llu  true count %+.1f  dealer %s\n", (unsigned long long)r.round,
+                r.trueCount10 / 10.0, CardsText(r.dealerCards, r.dealerCardCount).c_str());
+    for (int s = 0; s < r.seatCount; ++s) {
+        const BJHistorySeat& seat = r.seats[s];
+        std::printf("  seat %d  bet %d  net %+d\n", seat.seat + 1, seat.bet, seat.net);
+        for (int h = 0; h < seat.handCount; ++h) {
+            const BJHistoryHand& hand = seat.hands[h];
+            std::printf("    %-20s outcome %+d%s%s\n", CardsText(hand.cards, hand.cardCount).c_str(),
+                        hand.outcome, hand.doubled ? ", doubled" : "",
+                        hand.surrendered ? ", surrendered" : "");
+        }
+    }
+}
+
+static void Scan(const std::string& path, std::uint64_t dump)
+{
+    auto start = std::chrono::steady_clock::now();
+    BJHandHistoryFile file(path);
+
+    std::uint64_t seen = 0, seatRounds = 0, hands = 0, doubles = 0, splits = 0;
+    long long     net = 0, wagered = 0;
+
+    file.forEach([&](const BJHistoryRound& r) {
+        if (seen < dump)
+            DumpRound(r);
+        ++seen;
+        for (int s = 0; s < r.seatCount; ++s) {
+            const BJHistorySeat& seat = r.seats[s];
+            ++seatRounds;
+            net     += seat.net;
+            wagered += seat.bet;
+            hands   += seat.handCount;
+            splits  += seat.handCount - 1;
+            for (int h = 0; h < seat.handCount; ++h)
+                doubles += seat.hands[h].doubled;
+        }
+    });
+    const double secs = Seconds(start);
+
+    std::printf("rounds          %llu in %d blocks, %zu bytes (%.2f a round)\n",
+                (unsigned long long)seen, file.getBlockCount(), file.getSize(),
+                seen ? (double)file.getSize() / (double)seen : 0.0);
+    std::printf("seat-rounds     %llu, %llu hands, %llu doubles, %llu splits\n",
+                (unsigned long long)seatRounds, (unsigned long long)hands,
+                (unsigned long long)doubles, (unsigned long long)splits);
+    std::printf("net             %+lld chips on %lld wagered (%.4f%%)\n", net, wagered,
+                wagered ? 100.0 * (double)net / (double)wagered : 0.0);
+    std::printf("scan            %.3f s, %.1f M rounds/s, %.0f MB/s\n", secs,
+                (double)seen / secs / 1e6, (double)file.getSize() / secs / 1e6);
+}
+
+// Plays rounds on a table whose seats all rebet the same flat stake from
+// a fresh bankroll, handing each round to the recorder. Returns the net.
+template <class Recorder>
+static long long PlayRounds(BJGame& game, BJBasicStrategy& strategy, Recorder& rec,
+                            std::uint64_t rounds, int bet, int bankroll)
+{
+    long long net = 0;
+    for (std::uint64_t k = 0; k < rounds; ++k) {
+        for (int i = 0; i < game.getPlayerCount(); ++i) {
+            BJPlayer& p = game.GetPlayer(i);
+            p.adjustChips(bankroll - bet - p.getChips());
+            p.setBet(bet);
+            p.setSplitBet(0);
+        }
+        BJPlayRecordedRound(game, strategy, rec);
+        for (int i = 0; i < game.getPlayerCount(); ++i)
+            net += game.GetPlayer(i).getChips() - bankroll;
+    }
+    return net;
+}
+
+int main(int argc, char** argv)
+{
+    std::string   writePath, scanPath;
+    std::uint64_t rounds  = 1000000;
+    int           players = 1;
+    int           decks   = 6;
+    std::string   rules   = "s17";
+    std::uint64_t seed    = 1;
+    int           blockKB = (int)(BJHistoryBlockBytes / 1024);
+    std::uint64_t dump    = 0;
+    bool          async   = false;
+    int           threads = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--async")) {
+            async = true;
+            continue;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--write"))   writePath = val;
+        else if (!std::strcmp(arg, "--scan"))    scanPath  = val;
+        else if (!std::strcmp(arg, "--rounds"))  rounds    = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--players")) players   = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))   decks     = std::atoi(val);
+        else if (!std::strcmp(arg, "--rules"))   rules     = val;
+        else if (!std::strcmp(arg, "--seed"))    seed      = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--block"))   blockKB   = std::atoi(val);
+        else if (!std::strcmp(arg, "--dump"))    dump      = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--threads")) threads   = std::atoi(val);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    BJRuntimeRules r;
+    if (rules == "s17")
+        r = BJRuntimeRules::from(BJRulesS17());
+    else if (rules == "h17")
+        r = BJRuntimeRules::from(BJRulesH17());
+    else if (rules != "app") {
+        PrintUsage();
+        return 1;
+    }
+
+    if (writePath.empty() == scanPath.empty() || players < 1 || players > BJHistoryMaxSeats ||
+        blockKB < 1 || threads < 1 || threads > BJEventLog::MaxChannels || (threads > 1 && !async)) {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        if (!scanPath.empty()) {
+            Scan(scanPath, dump);
+            return 0;
+        }
+
+        const int bet      = 10;
+        const int bankroll = bet * 1000;
+
+        const BJStrategyTable table = BJBasicStrategyFor(r, decks);
+        BJBasicStrategy strategy(table);
+
+        std::ofstream out(writePath, std::ios::binary);
+        if (!out)
+            throw std::runtime_error("Cannot create " + writePath);
+        BJHandHistoryWriter writer(out, r, (std::size_t)blockKB * 1024);
+
+        long long net = 0;
+        std::uint64_t lost = 0;
+        auto start = std::chrono::steady_clock::now();
+        if (!async) {
+            BJGame game(players, bankroll, decks, 0.75, r);
+            game.GetShoe().seed(seed);
+            net = PlayRounds(game, strategy, writer, rounds, bet, bankroll);
+        } else {
+            BJHistoryEventSink sink(writer);
+            BJEventLog         log(std::ref(sink));
+
+            // each table its own game, strategy and channel; a full ring
+            // holds its table up rather than losing rounds
+            std::vector<long long>           nets(threads, 0);
+            std::vector<std::exception_ptr>  errors(threads);
+            std::vector<std::thread>         tables;
+            BJStreamSplitter<BJXoshiro256ss> splitter(seed);
+            for (int t = 0; t < threads; ++t) {
+                BJEventChannel* ch = &log.openChannel(BJEventOverflow::Wait);
+                const BJXoshiro256ss engine = splitter.next();
+                const std::uint64_t  share  = rounds / threads + ((std::uint64_t)t < rounds % threads);
+                tables.emplace_back([&, t, ch, engine, share]() {
+                    try {
+                        BJBasicStrategy st(table);
+                        BJGame game(players, bankroll, decks, 0.75, r);
+                        game.GetShoe().setEngine(engine);
+                        BJEventRecorder rec(*ch);
+                        nets[t] = PlayRounds(game, st, rec, share, bet, bankroll);
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+            for (auto& t : tables)
+                t.join();
+            log.stop();
+            for (int t = 0; t < threads; ++t) {
+                if (errors[t])
+                    std::rethrow_exception(errors[t]);
+                net += nets[t];
+            }
+            lost = sink.getRoundsLost() + (rounds - sink.getRoundsWritten());
+            std::printf("events          %llu through %d rings, %llu dropped\n",
+                        (unsigned long long)log.getDelivered(), threads,
+                        (unsigned long long)log.getDropped());
+        }
+        writer.close();
+        const double secs = Seconds(start);
+
+        std::printf("rounds          %llu x %d seats, seed %llu\n",
+                    (unsigned long long)rounds, players, (unsigned long long)seed);
+        std::printf("written         %llu bytes (%.2f a round) in %.3f s\n",
+                    (unsigned long long)writer.getBytesWritten(),
+                    (double)writer.getBytesWritten() / (double)rounds, secs);
+        std::printf("net             %+lld chips\n", net);
+        if (async)
+            std::printf("lost            %llu rounds\n", (unsigned long long)lost);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjhistory: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------
+// bjquery: filters and aggregates seat-rounds across hand-history archives.
+//
+//   bjquery FILE... [--upcard A|2-10] [--total N|LO-HI] [--soft 0|1]
+//           [--pair 0|1] [--action stand|hit|double|split|surrender|none]
+//           [--tc-min X] [--tc-max X] [--outcome win|push|loss]
+//           [--seat N] [--by none|upcard|total|action|count|seat]
+//           [--threads T]
+//
+// Prints, per group, the seat-rounds that pass every filter, how they came
+// out and their return per chip bet with a 95% interval, then how much of
+// the archives the index let it skip and the scan speed. --tc-min and
+// --tc-max bound the Hi-Lo true count at the deal (e.g. --tc-min 2.5).
+//---------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BJHistoryQuery.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjquery FILE... [--upcard A|2-10] [--total N|LO-HI] [--soft 0|1]\n"
+                "               [--pair 0|1] [--action stand|hit|double|split|surrender|none]\n"
+                "               [--tc-min X] [--tc-max X] [--outcome win|push|loss]\n"
+                "               [--seat N] [--by none|upcard|total|action|count|seat]\n"
+                "               [--threads T]\n");
+}
+
+static bool ParseUpcard(const char* s, int& out)
+{
+    if (!std::strcmp(s, "A") || !std::strcmp(s, "a")) {
+        out = 1;
+        return true;
+    }
+    out = std::atoi(s);
+    return out >= 2 && out <= 10;
+}
+
+static bool ParseTotal(const char* s, int& lo, int& hi)
+{
+    const char* dash = std::strchr(s, '-');
+    lo = std::atoi(s);
+    hi = dash ? std::atoi(dash + 1) : lo;
+    return lo >= 2 && lo <= hi && hi <= 21;
+}
+
+static bool ParseAction(const char* s, int& out)
+{
+    if (!std::strcmp(s, "none")) {
+        out = BJNoAction;
+        return true;
+    }
+    for (int a = 0; a < BJActionCount; ++a) {
+        if (!std::strcmp(s, BJActionName((BJAction)a))) {
+            out = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ParseOutcome(const char* s, int& out)
+{
+    if      (!std::strcmp(s, "win"))  out = 1;
+    else if (!std::strcmp(s, "push")) out = 0;
+    else if (!std::strcmp(s, "loss")) out = -1;
+    else return false;
+    return true;
+}
+
+static bool ParseGroup(const char* s, BJHistoryGroup& out)
+{
+    for (int g = 0; g <= (int)BJHistoryGroup::Seat; ++g) {
+        const char* name = BJHistoryGroupName((BJHistoryGroup)g);
+        if (!std::strcmp(s, name) || (g == 0 && !std::strcmp(s, "none"))) {
+            out = (BJHistoryGroup)g;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void PrintTotals(const char* label, const BJHistoryTotals& t)
+{
+    const double n  = t.seatRounds ? (double)t.seatRounds : 1.0;     // 0% of nothing
+    const double ev = t.wagered ? (double)t.net / (double)t.wagered : 0.0;
+    const BJInterval ci = t.perBet.confidenceInterval();
+    std::printf("%-12s %12llu  %5.1f%% %5.1f%% %5.1f%%  %+12lld  %+8.3f%%  [%+.3f%%, %+.3f%%]\n",
+                label, (unsigned long long)t.seatRounds,
+                100.0 * (double)t.wins / n, 100.0 * (double)t.pushes / n,
+                100.0 * (double)t.losses / n, t.net, 100.0 * ev, 100.0 * ci.lo, 100.0 * ci.hi);
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> paths;
+    BJHistoryQuery           query;
+    BJHistoryGroup           group   = BJHistoryGroup::None;
+    int                      threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (std::strncmp(arg, "--", 2) != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        bool ok = true;
+        if      (!std::strcmp(arg, "--upcard"))  ok = ParseUpcard(val, query.upcard);
+        else if (!std::strcmp(arg, "--total"))   ok = ParseTotal(val, query.totalMin, query.totalMax);
+        else if (!std::strcmp(arg, "--soft"))    query.soft = std::atoi(val) != 0;
+        else if (!std::strcmp(arg, "--pair"))    query.pair = std::atoi(val) != 0;
+        else if (!std::strcmp(arg, "--action"))  ok = ParseAction(val, query.action);
+        else if (!std::strcmp(arg, "--tc-min"))  query.countMin = (int)std::ceil(std::atof(val) * 10.0 - 1e-9);
+        else if (!std::strcmp(arg, "--tc-max"))  query.countMax = (int)std::floor(std::atof(val) * 10.0 + 1e-9);
+        else if (!std::strcmp(arg, "--outcome")) ok = ParseOutcome(val, query.outcome);
+        else if (!std::strcmp(arg, "--seat"))    query.seat = std::atoi(val) - 1;
+        else if (!std::strcmp(arg, "--by"))      ok = ParseGroup(val, group);
+        else if (!std::strcmp(arg, "--threads")) threads = std::atoi(val);
+        else                                     ok = false;
+        if (!ok) {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    if (paths.empty() || query.seat < -1 || query.seat >= BJHistoryMaxSeats || threads < 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        const BJHistoryResult r = BJRunHistoryQuery(paths, query, group, threads);
+
+        std::printf("%-12s %12s  %6s %6s %6s  %12s  %9s  %s\n", BJHistoryGroupName(group),
+                    "seat-rounds", "win", "push", "loss", "net", "return", "95% interval");
+        for (int g = 0; g < (int)r.groups.size(); ++g) {
+            if (!r.groups[g].seatRounds)
+                continue;
+            PrintTotals(BJHistoryGroupLabel(group, g).c_str(), r.groups[g]);
+        }
+        if (group != BJHistoryGroup::None)
+            PrintTotals("all", r.total());
+
+        const std::uint64_t rounds = r.roundsScanned + r.roundsSkipped;
+        std::printf("\nrounds          %llu in %zu files, %llu decoded, %llu skipped by the index\n",
+                    (unsigned long long)rounds, paths.size(), (unsigned long long)r.roundsScanned,
+                    (unsigned long long)r.roundsSkipped);
+        std::printf("blocks          %d read, %d skipped\n", r.blocksScanned, r.blocksSkipped);
+        std::printf("scan            %.3f s on %d threads, %.1f M rounds/s, %.0f MB/s\n",
+                    r.seconds, r.threads, (double)r.roundsScanned / r.seconds / 1e6,
+                    (double)r.bytesScanned / r.seconds / 1e6);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjquery: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------
+// bjramp: count-driven bet-ramp optimizer.
+//
+//   bjramp [--rounds N] [--threads T] [--tables K] [--decks D]
+//          [--penetration F] [--seed S] [--rules s17|h17|app]
+//          [--count hilo|ko|hiopti|hioptii|omegaii|zen]
+//          [--bankroll UNITS] [--ror P] [--spread M]
+//          [--ladder 1,2,4,...] [--top N] [--verify]
+//
+// Plays one flat-bet basic-strategy pass, files every result under its
+// true count, then prices every candidate ramp on that single card stream.
+// --verify replays the winner with real bets as a check.
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BJBetRamp.h"
+#include "BJEngine.h"
+#include "BJSimulator.h"
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjramp [--rounds N] [--threads T] [--tables K] [--decks D]\n"
+                "              [--penetration F] [--seed S] [--rules s17|h17|app]\n"
+                "              [--count hilo|ko|hiopti|hioptii|omegaii|zen]\n"
+                "              [--bankroll UNITS] [--ror P] [--spread M]\n"
+                "              [--ladder 1,2,4,...] [--top N] [--verify]\n");
+}
+
+static std::vector<int> ParseLadder(const char* text)
+{
+    std::vector<int> out;
+    while (*text) {
+        char* end = nullptr;
+        const long v = std::strtol(text, &end, 10);
+        if (end == text)
+            break;
+        out.push_back((int)v);
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return out;
+}
+
+template <class Rules>
+static int Run(const BJSimConfig& cfg, BJCountSystem system, double bankroll, double ror,
+               int spread, const std::vector<int>& ladder, int top, bool verify)
+{
+    const BJStrategyTable table = BJBasicStrategyFor(BJRuntimeRules::from(Rules()), cfg.deckCount);
+    const BJBasicStrategy strategy(table);
+
+    const BJRampStats stats = BJSimulateCounts<Rules>(cfg, strategy, system);
+
+    std::printf("count           %s, %d decks, %.0f%% penetration\n",
+                BJCountSystemName(system), cfg.deckCount, 100.0 * cfg.penetration);
+    std::printf("rounds          %llu in %.3f s\n", (unsigned long long)stats.rounds, stats.seconds);
+    std::printf("  TC     share    edge\n");
+    const double seats = (double)stats.totalSeats();
+    for (int s = 0; s < BJBetRampSteps; ++s) {
+        const double n = (double)stats.seats[s];
+        const std::string label = s == 0 ? "<1"
+                                : (s == BJBetRampSteps - 1 ? ">=" : "") + std::to_string(s);
+        std::printf("  %-4s  %6.2f%%  %+6.2f%%\n", label.c_str(),
+                    seats ? 100.0 * n / seats : 0.0, n ? 100.0 * stats.sumNet[s] / n : 0.0);
+    }
+
+    const std::vector<BJBetRamp> candidates = BJRampCandidates(ladder, spread);
+    const std::vector<BJRampResult> best = BJOptimizeRamps(stats, candidates, bankroll, ror,
+                                                           (unsigned)cfg.threads);
+
+    std::printf("candidates      %zu (spread <= %d), %zu within %.2f%% risk of ruin on %.0f units\n",
+                candidates.size(), spread, best.size(), 100.0 * ror, bankroll);
+    std::printf("  ramp                      avg bet   win/100     sd     RoR\n");
+    for (int i = 0; i < top && i < (int)best.size(); ++i) {
+        const BJRampResult& r = best[i];
+        std::printf("  %-24s %8.3f  %8.3f  %6.3f  %6.2f%%\n", r.ramp.toString().c_str(),
+                    r.averageBet, 100.0 * r.winRate, r.stdDev, 100.0 * r.riskOfRuin);
+    }
+
+    if (verify && !best.empty()) {
+        BJRampBet bets = { best[0].ramp, system };
+        const BJSimStats check = BJSimulate<Rules>(cfg, strategy, bets);
+        std::printf("verify          %s: %.3f units/100 +/- %.3f (%.3f s)\n",
+                    best[0].ramp.toString().c_str(), 100.0 * check.meanNet(),
+                    100.0 * check.standardError(), check.seconds);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    BJSimConfig cfg;
+    cfg.seed = BJRandomSeed();
+
+    std::string      rules    = "s17";
+    BJCountSystem    system   = BJCountSystem::HiLo;
+    double           bankroll = 1000.0;
+    double           ror      = 0.05;
+    int              spread   = 12;
+    int              top      = 10;
+    bool             verify   = false;
+    std::vector<int> ladder   = { 1, 2, 3, 4, 6, 8, 10, 12, 16 };
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--verify")) {
+            verify = true;
+            continue;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--rounds"))      cfg.rounds      = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--threads"))     cfg.threads     = std::atoi(val);
+        else if (!std::strcmp(arg, "--tables"))      cfg.tables      = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))       cfg.deckCount   = std::atoi(val);
+        else if (!std::strcmp(arg, "--penetration")) cfg.penetration = std::atof(val);
+        else if (!std::strcmp(arg, "--seed"))        cfg.seed        = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--rules"))       rules           = val;
+        else if (!std::strcmp(arg, "--bankroll"))    bankroll        = std::atof(val);
+        else if (!std::strcmp(arg, "--ror"))         ror             = std::atof(val);
+        else if (!std::strcmp(arg, "--spread"))      spread          = std::atoi(val);
+        else if (!std::strcmp(arg, "--top"))         top             = std::atoi(val);
+        else if (!std::strcmp(arg, "--ladder"))      ladder          = ParseLadder(val);
+        else if (!std::strcmp(arg, "--count")) {
+            if (!BJParseCountSystem(val, system)) {
+                PrintUsage();
+                return 1;
+            }
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    try {
+        if (rules == "s17")
+            return Run<BJRulesS17>(cfg, system, bankroll, ror, spread, ladder, top, verify);
+        if (rules == "h17")
+            return Run<BJRulesH17>(cfg, system, bankroll, ror, spread, ladder, top, verify);
+        if (rules == "app")
+            return Run<BJRuntimeRules>(cfg, system, bankroll, ror, spread, ladder, top, verify);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjramp: %s\n", e.what());
+        return 1;
+    }
+
+    PrintUsage();
+    return 1;
+}
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+// bjreplay: records rounds into a round log and replays them.
+//
+//   bjreplay [--rounds N] [--players P] [--decks D] [--rules s17|h17|app]
+//            [--seed S] [--out FILE]
+//   bjreplay --in FILE [--show N]
+//
+// Without --in, plays N basic-strategy rounds recorded from --seed, times
+// the play and the replay of the log, and checks the replay ends where the
+// play did; --out keeps the log. With --in, replays a saved log (the app's
+// or one written here); --show N prints round N as it was dealt.
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "BJReplay.h"
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjreplay [--rounds N] [--players P] [--decks D] [--rules s17|h17|app]\n"
+                "                [--seed S] [--out FILE]\n"
+                "       bjreplay --in FILE [--show N]\n");
+}
+
+static double Seconds(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+static std::string HandText(const BJHand& h)
+{
+    std::string s;
+    for (const auto& c : h.GetCards()) {
+        if (!s.empty()) s += ' ';
+        s += c.getGlyph();
+    }
+    s += " (" + std::to_string(h.value()) + ")";
+    if (h.getStatus() == BJHandStatus::Surrendered)
+        s += " surrendered";
+    return s;
+}
+
+static void ShowRound(const BJRoundReplayer& r)
+{
+    const BJGame& g = r.GetGame();
+
+    std::printf("round %llu\n", (unsigned long long)r.getRound());
+    std::printf("  dealer   %s%s\n", HandText(g.GetDealer().GetHand()).c_str(),
+                r.getDealerPlayed() ? "" : ", did not draw");
+    for (int i = 0; i < g.getPlayerCount(); ++i) {
+        const BJPlayer& p = g.GetPlayer(i);
+        if (p.getBet() <= 0)
+            continue;
+        std::printf("  seat %d   %s, bet %d, outcome %d\n", i + 1,
+                    HandText(p.GetHand()).c_str(), p.getBet(), p.getRoundOutcomeMain());
+        if (p.hasSplitHand())
+            std::printf("           %s, bet %d, outcome %d\n",
+                        HandText(p.GetSplitHand()).c_str(), p.getSplitBet(), p.getRoundOutcomeSplit());
+        std::printf("           chips after %d\n", p.getChips());
+    }
+}
+
+static int ReplayFile(const std::string& path, std::uint64_t show)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("Cannot open " + path);
+    const BJRoundLog log = BJReadRoundLog(in);
+
+    BJRoundReplayer r(log);
+    auto start = std::chrono::steady_clock::now();
+
+    if (show) {
+        r.replayTo(show);
+        if (r.getRound() != show)
+            throw std::runtime_error("The log has only " + std::to_string(r.getRound()) + " rounds");
+        ShowRound(r);
+        return 0;
+    }
+
+    r.replayTo(log.getRoundCount());
+    const double secs = Seconds(start);
+
+    std::printf("rounds          %llu, seed %llu, %d seats\n", (unsigned long long)r.getRound(),
+                (unsigned long long)log.getHeader().seed, log.getSeatCount());
+    std::printf("log             %zu bytes (%.1f a round)\n", log.getBytes().size(),
+                r.getRound() ? (double)log.getBytes().size() / (double)r.getRound() : 0.0);
+    std::printf("replay          %.3f s, %.0f rounds/sec, every round matches\n",
+                secs, secs > 0.0 ? (double)r.getRound() / secs : 0.0);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    std::uint64_t rounds  = 1000000;
+    int           players = 1;
+    int           decks   = 6;
+    std::string   rules   = "s17";
+    std::uint64_t seed    = 1;
+    std::string   outPath, inPath;
+    std::uint64_t show    = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--rounds"))  rounds  = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--players")) players = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))   decks   = std::atoi(val);
+        else if (!std::strcmp(arg, "--rules"))   rules   = val;
+        else if (!std::strcmp(arg, "--seed"))    seed    = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--out"))     outPath = val;
+        else if (!std::strcmp(arg, "--in"))      inPath  = val;
+        else if (!std::strcmp(arg, "--show"))    show    = std::strtoull(val, nullptr, 10);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    BJRuntimeRules r;
+    if (rules == "s17")
+        r = BJRuntimeRules::from(BJRulesS17());
+    else if (rules == "h17")
+        r = BJRuntimeRules::from(BJRulesH17());
+    else if (rules != "app") {
+        PrintUsage();
+        return 1;
+    }
+
+    if (players < 1 || players > BJRoundLog::MaxSeats) {
+        PrintUsage();
+        return 1;
+    }
+
+    try {
+        if (!inPath.empty())
+            return ReplayFile(inPath, show);
+
+        const int bet      = 10;
+        const int bankroll = bet * 1000;
+
+        const BJStrategyTable table = BJBasicStrategyFor(r, decks);
+        BJBasicStrategy strategy(table);
+
+        BJGame game(players, bankroll, decks, 0.75, r);
+        BJRoundLog log;
+        log.start(game, seed);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t k = 0; k < rounds; ++k) {
+            for (int i = 0; i < players; ++i) {
+                BJPlayer& p = game.GetPlayer(i);
+                p.adjustChips(bankroll - bet - p.getChips());
+                p.setBet(bet);
+                p.setSplitBet(0);
+            }
+            BJPlayRecordedRound(game, strategy, log);
+        }
+        const double playSecs = Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        BJRoundReplayer replay(log);
+        replay.replayTo(rounds);
+        const double replaySecs = Seconds(start);
+
+        for (int i = 0; i < players; ++i) {
+            if (replay.GetGame().GetPlayer(i).getChips() != game.GetPlayer(i).getChips())
+                throw std::runtime_error("Replay ended with different chips");
+        }
+
+        std::printf("rounds          %llu x %d seats, seed %llu\n",
+                    (unsigned long long)rounds, players, (unsigned long long)seed);
+        std::printf("log             %zu bytes (%.1f a round)\n", log.getBytes().size(),
+                    (double)log.getBytes().size() / (double)rounds);
+        std::printf("play            %.3f s, %.0f rounds/sec\n", playSecs, (double)rounds / playSecs);
+        std::printf("replay          %.3f s, %.0f rounds/sec, every round matches\n",
+                    replaySecs, (double)rounds / replaySecs);
+
+        if (!outPath.empty()) {
+            std::ofstream out(outPath, std::ios::binary);
+            if (!out)
+                throw std::runtime_error("Cannot create " + outPath);
+            BJWriteRoundLog(out, log);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjreplay: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
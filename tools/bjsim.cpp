@@ -0,0 +1,239 @@
+//---------------------------------------------------------------------------
+// bjsim: multi-threaded Monte Carlo rounds on the headless engine.
+//
+//   bjsim [--rounds N] [--threads T] [--tables K] [--players P] [--decks D]
+//         [--penetration F] [--seed S] [--rules s17|h17|app]
+//         [--strategy mimic|neverbust|basic|composition]
+//         [--detail] [--checkpoints K]
+//
+// The same --seed and --tables reproduce a run exactly, for any --threads.
+// --detail adds skew, kurtosis, a confidence interval and breakdowns by
+// upcard, first action and final totals; --checkpoints prints the running
+// result K times while the run goes on.
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "BJEngine.h"
+#include "BJSimulator.h"
+#include "BJStatistics.h"
+#include "BJStrategies.h"
+#include "BJStrategyGenerator.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjsim [--rounds N] [--threads T] [--tables K] [--players P] [--decks D]\n"
+                "             [--penetration F] [--seed S] [--rules s17|h17|app]\n"
+                "             [--strategy mimic|neverbust|basic|composition]\n"
+                "             [--detail] [--checkpoints K]\n");
+}
+
+static void PrintReport(const BJSimConfig& cfg, const BJSimStats& s)
+{
+    std::printf("seed            %llu (%d tables)\n", (unsigned long long)cfg.seed, cfg.tables);
+    std::printf("rounds          %llu (%llu seat-rounds)\n",
+                (unsigned long long)s.rounds, (unsigned long long)s.seatRounds);
+    std::printf("house edge      %.4f%% +/- %.4f%%\n",
+                100.0 * s.houseEdge(), 100.0 * s.standardError());
+    std::printf("variance        %.4f (per unit bet)\n", s.variance());
+    std::printf("win/push/loss   %.4f / %.4f / %.4f\n",
+                (double)s.wins   / (double)s.seatRounds,
+                (double)s.pushes / (double)s.seatRounds,
+                (double)s.losses / (double)s.seatRounds);
+
+    std::uint64_t decisions = 0;
+    for (int a = 0; a < BJActionCount; ++a)
+        decisions += s.actions[a];
+    for (int a = 0; a < BJActionCount; ++a) {
+        std::printf("  %-10s    %.4f\n", BJActionName((BJAction)a),
+                    decisions ? (double)s.actions[a] / (double)decisions : 0.0);
+    }
+
+    std::printf("elapsed         %.3f s\n", s.seconds);
+    std::printf("rounds/sec      %.0f\n", s.roundsPerSecond());
+}
+
+static const char* TotalName(int slot)
+{
+    static char buf[8];
+    switch (slot) {
+        case BJTotalBust:        return "bust";
+        case BJTotalBlackjack:   return "bj";
+        case BJTotalSurrendered: return "surr";
+        default:
+            std::snprintf(buf, sizeof buf, "%d", slot);
+            return buf;
+    }
+}
+
+static void PrintDetail(const BJRoundStats& s)
+{
+    const BJInterval ci = s.net.confidenceInterval();
+    std::printf("mean net        %+.5f (95%% CI %+.5f .. %+.5f)\n", s.net.mean, ci.lo, ci.hi);
+    std::printf("std dev         %.4f, skew %.4f, excess kurtosis %.4f\n",
+                s.net.stdDev(), s.net.skewness(), s.net.kurtosis());
+
+    std::printf("net histogram   (bets: share)\n");
+    for (int i = 0; i < BJNetOutcomes; ++i) {
+        if (s.netCounts[i] == 0)
+            continue;
+        std::printf("  %+5.1f         %.5f\n", (double)(i - BJNetTenthsMax) / 10.0,
+                    (double)s.netCounts[i] / (double)s.net.n);
+    }
+
+    std::printf("by upcard       (share, mean net +/- se)\n");
+    for (int u = 1; u <= 10; ++u) {
+        const BJMoments& m = s.netByUpcard[u];
+        std::printf("  %-2s            %.4f  %+.4f +/- %.4f\n", u == 1 ? "A" : TotalName(u),
+                    (double)m.n / (double)s.net.n, m.mean, m.standardError());
+    }
+
+    std::printf("by first action (share, mean net +/- se)\n");
+    for (int a = 0; a < BJFirstActionSlots; ++a) {
+        const BJMoments& m = s.netByAction[a];
+        std::printf("  %-10s    %.4f  %+.4f +/- %.4f\n",
+                    a == BJNoAction ? "none" : BJActionName((BJAction)a),
+                    (double)m.n / (double)s.net.n, m.mean, m.standardError());
+    }
+
+    std::uint64_t hands = 0;
+    for (int t = 0; t < BJTotalSlots; ++t)
+        hands += s.playerTotals[t];
+    std::printf("final totals    (player hands, dealer)\n");
+    for (int t = 0; t < BJTotalSlots; ++t) {
+        if (s.playerTotals[t] == 0 && s.dealerTotals[t] == 0)
+            continue;
+        std::printf("  %-4s          %.4f  %.4f\n", TotalName(t),
+                    (double)s.playerTotals[t] / (double)hands,
+                    (double)s.dealerTotals[t] / (double)s.rounds);
+    }
+}
+
+// The summary report reads the flat counters; fill them from the detail.
+static BJSimStats Summary(const BJRoundStats& d)
+{
+    BJSimStats s;
+    s.rounds     = d.rounds;
+    s.seatRounds = d.net.n;
+    s.sumNet     = d.net.mean * (double)d.net.n;
+    s.sumNetSq   = d.net.m2 + d.net.mean * d.net.mean * (double)d.net.n;
+    s.wins       = d.wins;
+    s.pushes     = d.pushes;
+    s.losses     = d.losses;
+    for (int a = 0; a < BJActionCount; ++a)
+        s.actions[a] = d.actions[a];
+    s.seconds    = d.seconds;
+    return s;
+}
+
+struct RunOptions {
+    bool detail      = false;
+    int  checkpoints = 0;
+};
+
+template <class Rules, class Strategy>
+static BJSimStats Run(const BJSimConfig& cfg, const RunOptions& opt, const Strategy& strategy)
+{
+    if (!opt.detail && opt.checkpoints == 0)
+        return BJSimulate<Rules>(cfg, strategy);
+
+    const BJRoundStats d = BJSimulateDetailed<Rules>(cfg, strategy, opt.checkpoints,
+        [](int c, const BJRoundStats& s) {
+            const BJInterval ci = s.net.confidenceInterval();
+            std::printf("checkpoint %-4d %llu rounds, house edge %.4f%% (95%% CI %.4f%% .. %.4f%%)\n",
+                        c + 1, (unsigned long long)s.rounds,
+                        -100.0 * s.net.mean, -100.0 * ci.hi, -100.0 * ci.lo);
+            std::fflush(stdout);
+        });
+    if (opt.detail)
+        PrintDetail(d);
+    return Summary(d);
+}
+
+template <class Rules>
+static bool RunStrategy(const BJSimConfig& cfg, const RunOptions& opt,
+                        const std::string& strategy, BJSimStats& out)
+{
+    if (strategy == "mimic")
+        out = Run<Rules>(cfg, opt, BJMimicDealerStrategy());
+    else if (strategy == "neverbust")
+        out = Run<Rules>(cfg, opt, BJNeverBustStrategy());
+    else if (strategy == "basic") {
+        const BJStrategyTable table = BJBasicStrategyFor(BJRuntimeRules::from(Rules()), cfg.deckCount);
+        out = Run<Rules>(cfg, opt, BJBasicStrategy(table));
+    }
+    else if (strategy == "composition")
+        out = Run<Rules>(cfg, opt, BJCompositionStrategy(Rules()));
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    BJSimConfig cfg;
+    cfg.seed = BJRandomSeed();
+
+    std::string rules    = "s17";
+    std::string strategy = "mimic";
+    RunOptions  opt;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!std::strcmp(arg, "--detail")) {
+            opt.detail = true;
+            continue;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--rounds"))      cfg.rounds      = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--threads"))     cfg.threads     = std::atoi(val);
+        else if (!std::strcmp(arg, "--tables"))      cfg.tables      = std::atoi(val);
+        else if (!std::strcmp(arg, "--players"))     cfg.players     = std::atoi(val);
+        else if (!std::strcmp(arg, "--decks"))       cfg.deckCount   = std::atoi(val);
+        else if (!std::strcmp(arg, "--penetration")) cfg.penetration = std::atof(val);
+        else if (!std::strcmp(arg, "--seed"))        cfg.seed        = std::strtoull(val, nullptr, 10);
+        else if (!std::strcmp(arg, "--rules"))       rules           = val;
+        else if (!std::strcmp(arg, "--strategy"))    strategy        = val;
+        else if (!std::strcmp(arg, "--checkpoints")) opt.checkpoints = std::atoi(val);
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    BJSimStats stats;
+    bool ok = false;
+    try {
+        if (rules == "s17")
+            ok = RunStrategy<BJRulesS17>(cfg, opt, strategy, stats);
+        else if (rules == "h17")
+            ok = RunStrategy<BJRulesH17>(cfg, opt, strategy, stats);
+        else if (rules == "app")
+            ok = RunStrategy<BJRuntimeRules>(cfg, opt, strategy, stats);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "bjsim: %s\n", e.what());
+        return 1;
+    }
+
+    if (!ok) {
+        PrintUsage();
+        return 1;
+    }
+
+    PrintReport(cfg, stats);
+    return 0;
+}
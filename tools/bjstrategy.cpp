@@ -0,0 +1,127 @@
+//---------------------------------------------------------------------------
+// bjstrategy: basic-strategy table generator from exact expected values.
+//
+//   bjstrategy [--decks D] [--rules s17|h17|app] [--threads T]
+//              [--name NAME] [--out FILE]
+//
+// Writes a self-contained header holding one constexpr BJStrategyTable;
+// without --out the header goes to stdout.
+//---------------------------------------------------------------------------
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "BJStrategyGenerator.h"
+
+static void PrintUsage()
+{
+    std::printf("usage: bjstrategy [--decks D] [--rules s17|h17|app] [--threads T]\n"
+                "                  [--name NAME] [--out FILE]\n");
+}
+
+// BJBasicStrategyS17.h -> BJBasicStrategyS17H, matching the engine's guards.
+static std::string GuardFor(const std::string& path)
+{
+    std::string base = path.substr(path.find_last_of("/\\") + 1);
+    const std::size_t dot = base.find_last_of('.');
+    if (dot != std::string::npos)
+        base = base.substr(0, dot);
+
+    std::string guard;
+    for (char c : base)
+        guard += std::isalnum((unsigned char)c) ? c : '_';
+    return guard + "H";
+}
+
+static void WriteHeader(std::ostream& out, const std::string& guard, const BJStrategyTable& table,
+                        const std::string& name, const std::string& comment)
+{
+    const char* rule = "//---------------------------------------------------------------------------\n";
+    out << rule << "#ifndef " << guard << "\n#define " << guard << "\n" << rule << "\n";
+    out << "// Generated by tools/bjstrategy; do not edit by hand.\n\n";
+    out << "#include \"BJStrategyTable.h\"\n\n";
+    BJWriteStrategyTable(out, table, name, comment);
+    out << "\n" << rule << "#endif\n";
+}
+
+int main(int argc, char** argv)
+{
+    int         decks   = 6;
+    unsigned    threads = 0;
+    std::string rules   = "s17";
+    std::string name    = "BJBasicStrategyTable";
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!std::strcmp(arg, "--help") || !std::strcmp(arg, "-h")) {
+            PrintUsage();
+            return 0;
+        }
+        if (!val) {
+            PrintUsage();
+            return 1;
+        }
+
+        if      (!std::strcmp(arg, "--decks"))   decks   = std::atoi(val);
+        else if (!std::strcmp(arg, "--threads")) threads = (unsigned)std::atoi(val);
+        else if (!std::strcmp(arg, "--rules"))   rules   = val;
+        else if (!std::strcmp(arg, "--name"))    name    = val;
+        else if (!std::strcmp(arg, "--out"))     outPath = val;
+        else {
+            PrintUsage();
+            return 1;
+        }
+        ++i;
+    }
+
+    BJRuntimeRules r;
+    if (rules == "s17")
+        r = BJRuntimeRules::from(BJRulesS17());
+    else if (rules == "h17")
+        r = BJRuntimeRules::from(BJRulesH17());
+    else if (rules != "app") {
+        PrintUsage();
+        return 1;
+    }
+    if (decks < 1 || decks > 8) {
+        std::fprintf(stderr, "bjstrategy: --decks must be 1..8\n");
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const BJStrategyTable table = BJGenerateStrategyTable(r, decks, threads);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ostringstream comment;
+    comment << decks << " deck" << (decks > 1 ? "s" : "") << ", "
+            << (r.hitSoft17() ? "H17" : "S17")
+            << (r.doubleAfterSplit() ? ", DAS" : ", no DAS")
+            << (r.doubleAnyTwo() ? ", double any two" : ", double 9-11")
+            << (r.lateSurrender() ? ", late surrender" : "")
+            << (r.dealerPeek() ? ", peek" : ", no peek")
+            << ", blackjack pays " << r.blackjackNumer() << ":" << r.blackjackDenom();
+
+    if (outPath.empty()) {
+        WriteHeader(std::cout, GuardFor(name), table, name, comment.str());
+    } else {
+        std::ofstream file(outPath);
+        if (!file) {
+            std::fprintf(stderr, "bjstrategy: cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+        WriteHeader(file, GuardFor(outPath), table, name, comment.str());
+    }
+
+    std::fprintf(stderr, "bjstrategy: %s in %.2f s\n", comment.str().c_str(), seconds);
+    return 0;
+}